@@ -24,7 +24,17 @@ int main(int argc, char* argv[]) {
 
     mun::Error error;
     if (auto runtime = mun::make_runtime(argv[1], options, &error)) {
+        mun::DiagnosticSink sink;
+        sink.on_invoke_error = [](std::string_view fn_name, const mun::InvokeError& error, void*) {
+            std::cerr << mun::to_string(fn_name, error) << std::endl;
+        };
+        sink.on_field_error = [](std::string_view field_name, const mun::FieldError& error, void*) {
+            std::cerr << mun::to_string(field_name, error) << std::endl;
+        };
+        runtime->set_diagnostic_sink(sink);
+
         auto ctx = mun::invoke_fn<mun::StructRef>(*runtime, "new_sim").wait();
+        mun::Function<void(mun::StructRef, float)> sim_update(*runtime, "sim_update");
 
         using clock_t = std::chrono::high_resolution_clock;
         using fsec_t = std::chrono::duration<float>;
@@ -38,7 +48,7 @@ int main(int argc, char* argv[]) {
             const auto elapsed =
                 std::chrono::duration_cast<fsec_t>(now - previous);
 
-            mun::invoke_fn<void>(*runtime, "sim_update", ctx, elapsed.count()).wait();
+            sim_update(ctx, elapsed.count()).wait();
             previous = now;
 
             mun::Error update_error;
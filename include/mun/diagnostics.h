@@ -0,0 +1,178 @@
+#ifndef MUN_DIAGNOSTICS_H_
+#define MUN_DIAGNOSTICS_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace mun {
+/** The reason that a function invocation failed. */
+enum class InvokeErrorKind : uint8_t {
+    /** The runtime returned an error while looking up the function. */
+    LookupFailed,
+    /** The runtime does not contain a function with the specified name. */
+    FunctionNotFound,
+    /** The number of arguments does not match the function's signature. */
+    ArgumentCountMismatch,
+    /** The type of an argument does not match the function's signature. */
+    ArgumentTypeMismatch,
+    /** The return type does not match the function's signature. */
+    ReturnTypeMismatch,
+};
+
+/** Describes why a function invocation failed.
+ *
+ * Type names point into the runtime's type information and remain valid until
+ * the runtime is updated.
+ */
+struct InvokeError {
+    InvokeErrorKind kind;
+
+    /** For `ArgumentTypeMismatch`, the index of the mismatching argument. */
+    uint16_t arg_index = 0;
+
+    /** For `ArgumentCountMismatch`, the number of arguments of the function. */
+    uint16_t expected_num_args = 0;
+
+    /** For `ArgumentCountMismatch`, the number of provided arguments. */
+    uint16_t found_num_args = 0;
+
+    /** For type mismatches, the name of the type in the function's signature. */
+    const char* expected_type = nullptr;
+
+    /** For type mismatches, the name of the provided type. */
+    const char* found_type = nullptr;
+
+    /** For `LookupFailed`, a copy of the runtime's error message. */
+    std::string message{};
+};
+
+/** The reason that accessing a struct field failed. */
+enum class FieldErrorKind : uint8_t {
+    /** The struct does not contain a field with the specified name. */
+    FieldNotFound,
+    /** The type of the field does not match the requested type. */
+    TypeMismatch,
+    /** The memory layout of the struct does not match its C++ mirror. */
+    LayoutMismatch,
+};
+
+/** Describes why accessing a struct field failed.
+ *
+ * Type names point into the runtime's type information and remain valid until
+ * the runtime is updated.
+ */
+struct FieldError {
+    FieldErrorKind kind;
+
+    /** The name of the struct's type. */
+    const char* struct_type = nullptr;
+
+    /** For `TypeMismatch`, the name of the field's type. */
+    const char* expected_type = nullptr;
+
+    /** For `TypeMismatch`, the name of the requested type. */
+    const char* found_type = nullptr;
+};
+
+/** A set of user-installable callbacks that receive diagnostics from the
+ * runtime bindings.
+ *
+ * Without callbacks, failures are only reported through return values.
+ */
+struct DiagnosticSink {
+    /** Called when invoking the function `fn_name` fails. */
+    void (*on_invoke_error)(std::string_view fn_name, const InvokeError& error,
+                            void* user_data) = nullptr;
+
+    /** Called when accessing the field `field_name` fails. */
+    void (*on_field_error)(std::string_view field_name, const FieldError& error,
+                           void* user_data) = nullptr;
+
+    /** User data that is passed to the callbacks. */
+    void* user_data = nullptr;
+};
+
+/** Formats a human-readable description of an invocation error.
+ *
+ * \param fn_name the name of the invoked function
+ * \param error an invocation error
+ * \return a description of the error
+ */
+inline std::string to_string(std::string_view fn_name, const InvokeError& error) {
+    std::string formatted;
+    switch (error.kind) {
+        case InvokeErrorKind::LookupFailed:
+            formatted.append("Failed to retrieve function info due to error: ")
+                .append(error.message.empty() ? "unknown error" : error.message);
+            break;
+        case InvokeErrorKind::FunctionNotFound:
+            formatted.append("Failed to obtain function '").append(fn_name).append("'");
+            break;
+        case InvokeErrorKind::ArgumentCountMismatch:
+            formatted.append("Invalid number of arguments. Expected: ")
+                .append(std::to_string(error.expected_num_args))
+                .append(". Found: ")
+                .append(std::to_string(error.found_num_args))
+                .append(".");
+            break;
+        case InvokeErrorKind::ArgumentTypeMismatch:
+            formatted.append("Invalid argument type at index ")
+                .append(std::to_string(error.arg_index))
+                .append(". Expected: ")
+                .append(error.expected_type)
+                .append(". Found: ")
+                .append(error.found_type)
+                .append(".");
+            break;
+        case InvokeErrorKind::ReturnTypeMismatch:
+            formatted.append("Invalid return type. Expected: ")
+                .append(error.expected_type)
+                .append(". Found: ")
+                .append(error.found_type)
+                .append(".");
+            break;
+    }
+    return formatted;
+}
+
+/** Formats a human-readable description of a field access error.
+ *
+ * \param field_name the name of the accessed field
+ * \param error a field access error
+ * \return a description of the error
+ */
+inline std::string to_string(std::string_view field_name, const FieldError& error) {
+    std::string formatted;
+    switch (error.kind) {
+        case FieldErrorKind::FieldNotFound:
+            formatted.append("StructRef `")
+                .append(error.struct_type)
+                .append("` does not contain field `")
+                .append(field_name)
+                .append("`.");
+            break;
+        case FieldErrorKind::TypeMismatch:
+            formatted.append("Mismatched types for `")
+                .append(error.struct_type)
+                .append("::")
+                .append(field_name)
+                .append("`. Expected: `")
+                .append(error.expected_type)
+                .append("`. Found: `")
+                .append(error.found_type)
+                .append("`.");
+            break;
+        case FieldErrorKind::LayoutMismatch:
+            formatted.append("Layout of `").append(error.struct_type).append("`");
+            if (!field_name.empty()) {
+                formatted.append(" at field `").append(field_name).append("`");
+            }
+            formatted.append(" does not match its C++ mirror.");
+            break;
+    }
+    return formatted;
+}
+}  // namespace mun
+
+#endif
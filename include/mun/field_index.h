@@ -0,0 +1,117 @@
+#ifndef MUN_FIELD_INDEX_H_
+#define MUN_FIELD_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "mun/runtime_capi.h"
+
+namespace mun {
+namespace details {
+/** Computes the 64-bit FNV-1a hash of `str`. */
+constexpr uint64_t fnv1a_hash(std::string_view str) noexcept {
+    uint64_t hash = 14695981039346656037ull;
+    for (const auto c : str) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/** A flat hash index from the field names of a struct to their indices.
+ *
+ * The index references the field names of the struct's type information, so
+ * it is only valid for as long as the type information is.
+ */
+class FieldIndex {
+    struct Slot {
+        std::string_view name;
+        uint16_t index;
+    };
+
+   public:
+    /** Builds an index of the fields in `struct_info`.
+     *
+     * \param struct_info the struct information to index
+     */
+    explicit FieldIndex(const MunStructInfo& struct_info) noexcept {
+        // Keep the load factor at or below 50% to keep probe sequences short.
+        size_t capacity = 1;
+        while (capacity < 2 * static_cast<size_t>(struct_info.num_fields)) {
+            capacity *= 2;
+        }
+
+        m_slots.resize(capacity);
+        m_mask = capacity - 1;
+        for (uint16_t idx = 0; idx < struct_info.num_fields; ++idx) {
+            const std::string_view name = struct_info.field_names[idx];
+            auto slot = static_cast<size_t>(fnv1a_hash(name)) & m_mask;
+            while (m_slots[slot].name.data() != nullptr) {
+                slot = (slot + 1) & m_mask;
+            }
+            m_slots[slot] = Slot{name, idx};
+        }
+    }
+
+    /** Finds the index of the field corresponding to `field_name`.
+     *
+     * \param field_name the name of the desired field
+     * \return possibly, the index of the desired field
+     */
+    std::optional<size_t> find(std::string_view field_name) const noexcept {
+        auto slot = static_cast<size_t>(fnv1a_hash(field_name)) & m_mask;
+        while (m_slots[slot].name.data() != nullptr) {
+            if (m_slots[slot].name == field_name) {
+                return std::make_optional(static_cast<size_t>(m_slots[slot].index));
+            }
+            slot = (slot + 1) & m_mask;
+        }
+        return std::nullopt;
+    }
+
+   private:
+    std::vector<Slot> m_slots;
+    size_t m_mask;
+};
+
+/** A lazily populated cache of `FieldIndex`es, keyed by struct type. */
+class FieldIndexCache {
+   public:
+    /** Retrieves the field index for the struct `type_info`, if it exists.
+     *
+     * \param type_info the type information of a struct
+     * \return possibly, a pointer to the field index of the struct
+     */
+    const FieldIndex* find(const MunTypeInfo& type_info) const noexcept {
+        const auto it = m_indices.find(&type_info);
+        return it != m_indices.end() ? &it->second : nullptr;
+    }
+
+    /** Retrieves the field index for the struct `type_info`, building it if
+     * it does not exist yet.
+     *
+     * \param type_info the type information of a struct
+     * \return the field index of the struct
+     */
+    const FieldIndex& get(const MunTypeInfo& type_info) noexcept {
+        if (const auto it = m_indices.find(&type_info); it != m_indices.end()) {
+            return it->second;
+        }
+
+        return m_indices.emplace(&type_info, FieldIndex(type_info.data.struct_)).first->second;
+    }
+
+    /** Removes all cached field indices. */
+    void clear() noexcept { m_indices.clear(); }
+
+   private:
+    std::unordered_map<const MunTypeInfo*, FieldIndex> m_indices;
+};
+}  // namespace details
+}  // namespace mun
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef MUN_FIELD_PATH_H_
+#define MUN_FIELD_PATH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "mun/diagnostics.h"
+#include "mun/marshal.h"
+#include "mun/runtime.h"
+#include "mun/struct_ref.h"
+
+namespace mun {
+/** A nested field of a Mun struct, such as `"b.c"`, that has been resolved in
+ * advance.
+ *
+ * The path is compiled once per root struct type into the combined offset of
+ * the field, with a pointer hop for every `struct(gc)` along the way; the
+ * offsets of `struct(value)`s are added up. Accessing the field then neither
+ * looks up names, nor queries type information, nor allocates or roots the
+ * intermediate structs. The path is compiled again when it is accessed
+ * through a struct of a different type, or after the runtime was updated.
+ */
+template <typename T>
+class FieldPath {
+   public:
+    /** Constructs a path to the field corresponding to `path`, whose field
+     * names are separated by dots.
+     *
+     * \param path the dot-separated names of the desired field
+     */
+    explicit FieldPath(std::string_view path) noexcept : m_path(path) {}
+
+    /** Retrieves the dot-separated names of the field. */
+    const std::string& path() const noexcept { return m_path; }
+
+    /** Tries to retrieve the copied value of the field in `s`.
+     *
+     * \param s a struct
+     * \param out_error a pointer that will optionally return an error
+     * \return possibly, the value of the field
+     */
+    std::optional<T> get(StructView s, FieldError* out_error = nullptr) const noexcept {
+        if (!resolve(s, out_error)) {
+            return std::nullopt;
+        }
+
+        return std::make_optional(Marshal<T>::copy_from(field_ptr(s), s.runtime(),
+                                                        std::make_optional(m_field_type)));
+    }
+
+    /** Tries to replace the value of the field in `s`, returning its original
+     * value.
+     *
+     * \param s a struct
+     * \param value the new value of the field
+     * \param out_error a pointer that will optionally return an error
+     * \return possibly, the value of the replaced field
+     */
+    std::optional<T> replace(StructView s, T value,
+                             FieldError* out_error = nullptr) const noexcept {
+        if (!resolve(s, out_error)) {
+            return std::nullopt;
+        }
+
+        return std::make_optional(Marshal<T>::swap_at(Marshal<T>::to(std::move(value)),
+                                                      field_ptr(s), s.runtime(),
+                                                      std::make_optional(m_field_type)));
+    }
+
+    /** Tries to set the value of the field in `s` to the provided `value`.
+     *
+     * \param s a struct
+     * \param value the new value of the field
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the field was set successfully
+     */
+    bool set(StructView s, T value, FieldError* out_error = nullptr) const noexcept {
+        if (!resolve(s, out_error)) {
+            return false;
+        }
+
+        Marshal<T>::move_to(Marshal<T>::to(std::move(value)), field_ptr(s),
+                            std::make_optional(m_field_type));
+        return true;
+    }
+
+    /** Compiles the path for the type of `s`, if it was not already compiled.
+     *
+     * \param s a struct
+     * \param out_error a pointer that will optionally return an error
+     * \return whether `s` contains the field with a matching type
+     */
+    bool resolve(StructView s, FieldError* out_error = nullptr) const noexcept {
+        return resolve(s.runtime(), *s.info(), out_error);
+    }
+
+    /** Compiles the path for the root struct type `type_info`, if it was not
+     * already compiled.
+     *
+     * \param runtime the runtime in which the struct type was defined
+     * \param type_info the type information of the root struct
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the root struct contains the field with a matching type
+     */
+    bool resolve(const Runtime& runtime, const MunTypeInfo& type_info,
+                 FieldError* out_error = nullptr) const noexcept {
+        const auto generation = runtime.generation();
+        if (&type_info != m_struct_type || generation != m_generation) {
+            m_struct_type = &type_info;
+            m_generation = generation;
+            m_field_type = compile(runtime, type_info);
+        }
+
+        // A failure is only reported to the diagnostic sink when the path is
+        // compiled, but it is returned on every access.
+        if (!m_field_type && out_error) {
+            *out_error = m_error;
+        }
+        return m_field_type != nullptr;
+    }
+
+   private:
+    using type = typename Marshal<T>::type;
+
+    const MunTypeInfo* compile(const Runtime& runtime,
+                               const MunTypeInfo& type_info) const noexcept {
+        m_hops.clear();
+        m_offset = 0;
+
+        const MunTypeInfo* struct_type = &type_info;
+        std::string_view path = m_path;
+        for (auto separator = path.find('.'); separator != std::string_view::npos;
+             separator = path.find('.')) {
+            const auto field_name = path.substr(0, separator);
+            const auto idx = details::find_index(runtime, *struct_type, field_name, &m_error);
+            if (!idx) {
+                return nullptr;
+            }
+
+            const auto& struct_info = struct_type->data.struct_;
+            const auto* field_type = struct_info.field_types[*idx];
+            if (field_type->data.tag != MunTypeInfoData_Tag::Struct) {
+                FieldError error{FieldErrorKind::TypeMismatch};
+                error.struct_type = struct_type->name;
+                error.expected_type = field_type->name;
+                error.found_type = ReturnTypeReflection<StructRef>::type_name();
+                details::report_field_error(runtime, field_name, error, &m_error);
+                return nullptr;
+            }
+
+            m_offset += struct_info.field_offsets[*idx];
+            if (field_type->data.struct_.memory_kind == MunStructMemoryKind::Gc) {
+                // A `struct(gc)` field stores a handle to another object.
+                m_hops.push_back(std::exchange(m_offset, 0));
+            }
+
+            struct_type = field_type;
+            path.remove_prefix(separator + 1);
+        }
+
+        if (const auto field = details::find_field<T>(runtime, *struct_type, path, &m_error)) {
+            m_offset += field->offset;
+            return field->type;
+        } else {
+            return nullptr;
+        }
+    }
+
+    type* field_ptr(StructView s) const noexcept {
+        auto byte_ptr = reinterpret_cast<std::byte*>(*s.raw());
+        for (const auto hop : m_hops) {
+            const auto handle = *reinterpret_cast<const MunGcPtr*>(byte_ptr + hop);
+            byte_ptr = reinterpret_cast<std::byte*>(*handle);
+        }
+        return reinterpret_cast<type*>(byte_ptr + m_offset);
+    }
+
+    std::string m_path;
+    mutable std::vector<size_t> m_hops;
+    mutable const MunTypeInfo* m_struct_type = nullptr;
+    mutable const MunTypeInfo* m_field_type = nullptr;
+    mutable size_t m_offset = 0;
+    mutable uint64_t m_generation = 0;
+    mutable FieldError m_error{FieldErrorKind::FieldNotFound};
+};
+}  // namespace mun
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef MUN_FUNCTION_HANDLE_H_
+#define MUN_FUNCTION_HANDLE_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "mun/invoke_fn.h"
+#include "mun/invoke_result.h"
+#include "mun/marshal.h"
+#include "mun/reflection.h"
+#include "mun/runtime.h"
+#include "mun/span.h"
+#include "mun/thread_pool.h"
+#include "mun/util.h"
+
+namespace mun {
+template <typename Signature>
+class Function;
+
+namespace details {
+/** Whether `T` can be written to the output span of a batched invocation. */
+template <typename T>
+constexpr bool is_batch_output_v = !std::is_void_v<T> && std::is_default_constructible_v<T>;
+}  // namespace details
+
+/** A typed handle to a runtime function.
+ *
+ * The function definition is looked up and its signature is validated once,
+ * after which invocations go straight through the cached function pointer.
+ * The handle re-resolves the function when the runtime's reload generation
+ * changes.
+ */
+template <typename Output, typename... Args>
+class Function<Output(Args...)> {
+    using fn_type =
+        typename Marshal<Output>::type(MUN_CALLTYPE*)(typename Marshal<Args>::type...);
+
+   public:
+    /** Constructs a handle to the runtime function corresponding to `fn_name`.
+     *
+     * \param runtime the runtime
+     * \param fn_name the name of the desired function
+     */
+    Function(Runtime& runtime, std::string_view fn_name) noexcept
+        : m_runtime(&runtime), m_name(fn_name) {
+        resolve();
+    }
+
+    /** Retrieves the name of the function. */
+    const std::string& name() const noexcept { return m_name; }
+
+    /** Retrieves whether the function exists in the runtime with a signature
+     * that matches `Output(Args...)`.
+     *
+     * The function is re-resolved first, if the runtime was updated.
+     */
+    bool is_valid() noexcept {
+        refresh();
+        return m_fn != nullptr;
+    }
+
+    /** Invokes the function with arguments `args`.
+     *
+     * If the function does not exist or has a mismatching signature, this
+     * falls back to `invoke_fn`, which reports the failure and returns an
+     * invocation result that can be retried.
+     *
+     * \param args zero or more arguments to supply to the function invocation
+     * \return an invocation result
+     */
+    InvokeResult<Output, Args...> operator()(Args... args) noexcept {
+        refresh();
+        if (m_fn && matches_arguments(std::index_sequence_for<Args...>(), args...)) {
+            if constexpr (std::is_same_v<Output, void>) {
+                m_fn(Marshal<Args>::to(args)...);
+                return InvokeResult<Output, Args...>(std::monostate{});
+            } else {
+                return InvokeResult<Output, Args...>(
+                    Marshal<Output>::from(m_fn(Marshal<Args>::to(args)...), *m_runtime));
+            }
+        }
+
+        return invoke_fn<Output, Args...>(*m_runtime, m_name, std::move(args)...);
+    }
+
+    /** Invokes the function once for every element of the `args` spans,
+     * writing the outputs to the corresponding elements of `out`.
+     *
+     * The signature is validated once for the whole batch, after which the
+     * function is called directly for every element.
+     *
+     * Only outputs that are default constructible can be batched, since `out`
+     * must hold an element for every invocation up front; e.g. `StructRef`
+     * outputs cannot.
+     *
+     * \param out a span that receives the outputs
+     * \param args a span per argument, each the same size as `out`
+     * \return whether the function was invoked; `false` if the function is
+     * invalid, the spans differ in size, or a struct argument has a mismatching
+     * type
+     */
+    template <typename O = Output, std::enable_if_t<details::is_batch_output_v<O>, int> = 0>
+    bool invoke_batch(Span<O> out, Span<const Args>... args) noexcept {
+        if (!prepare_batch(out.size(), args...)) {
+            return false;
+        }
+
+        run_batch(0, out.size(), out, args...);
+        return true;
+    }
+
+    /** Invokes the function once for every element of the `args` spans.
+     *
+     * The signature is validated once for the whole batch, after which the
+     * function is called directly for every element.
+     *
+     * \param args a span per argument, all of the same size
+     * \return whether the function was invoked; `false` if the function is
+     * invalid, the spans differ in size, or a struct argument has a mismatching
+     * type
+     */
+    template <typename O = Output, std::enable_if_t<std::is_void_v<O>, int> = 0>
+    bool invoke_batch(Span<const Args>... args) noexcept {
+        const size_t count = batch_size(args...);
+        if (!prepare_batch(count, args...)) {
+            return false;
+        }
+
+        run_batch(0, count, Span<char>(), args...);
+        return true;
+    }
+
+    /** Invokes the function once for every element of the `args` spans,
+     * spread across the threads of `pool`, writing the outputs to the
+     * corresponding elements of `out`.
+     *
+     * The function must be pure; i.e. invocations must not depend on each
+     * other. The signature is validated once on the calling thread. See
+     * `Runtime` for the operations that are allowed to run concurrently. As for
+     * `invoke_batch`, outputs must be default constructible.
+     *
+     * \param pool the thread pool to run the invocations on
+     * \param out a span that receives the outputs
+     * \param args a span per argument, each the same size as `out`
+     * \return whether the function was invoked
+     */
+    template <typename O = Output, std::enable_if_t<details::is_batch_output_v<O>, int> = 0>
+    bool invoke_parallel(ThreadPool& pool, Span<O> out, Span<const Args>... args) noexcept {
+        if (!prepare_batch(out.size(), args...)) {
+            return false;
+        }
+
+        pool.parallel_for(out.size(), grain_size(pool, out.size()),
+                          [&](size_t begin, size_t end) { run_batch(begin, end, out, args...); });
+        return true;
+    }
+
+    /** Invokes the function once for every element of the `args` spans,
+     * spread across the threads of `pool`.
+     *
+     * The function must be pure; i.e. invocations must not depend on each
+     * other. The signature is validated once on the calling thread. See
+     * `Runtime` for the operations that are allowed to run concurrently.
+     *
+     * \param pool the thread pool to run the invocations on
+     * \param args a span per argument, all of the same size
+     * \return whether the function was invoked
+     */
+    template <typename O = Output, std::enable_if_t<std::is_void_v<O>, int> = 0>
+    bool invoke_parallel(ThreadPool& pool, Span<const Args>... args) noexcept {
+        const size_t count = batch_size(args...);
+        if (!prepare_batch(count, args...)) {
+            return false;
+        }
+
+        pool.parallel_for(count, grain_size(pool, count), [&](size_t begin, size_t end) {
+            run_batch(begin, end, Span<char>(), args...);
+        });
+        return true;
+    }
+
+   private:
+    static size_t batch_size(const Span<const Args>&... args) noexcept {
+        static_assert(sizeof...(Args) > 0, "a batch requires at least one argument span");
+        return std::get<0>(std::forward_as_tuple(args...)).size();
+    }
+
+    static size_t grain_size(const ThreadPool& pool, size_t count) noexcept {
+        // Creates a few sub-ranges per thread, so idle threads can steal work.
+        return count / ((pool.num_workers() + 1) * 4) + 1;
+    }
+
+    /** Invokes the function for the elements `[begin, end)` of a validated
+     * batch. `out` is ignored for functions without output.
+     */
+    template <typename O>
+    void run_batch(size_t begin, size_t end, Span<O> out,
+                   const Span<const Args>&... args) const noexcept {
+        for (size_t idx = begin; idx < end; ++idx) {
+            if constexpr (std::is_void_v<Output>) {
+                m_fn(Marshal<Args>::to(args[idx])...);
+            } else {
+                out[idx] = Marshal<Output>::from(m_fn(Marshal<Args>::to(args[idx])...), *m_runtime);
+            }
+        }
+    }
+
+    bool prepare_batch(size_t count, const Span<const Args>&... args) noexcept {
+        refresh();
+        if (!m_fn || ((args.size() != count) || ...)) {
+            return false;
+        }
+
+        if constexpr (!(std::is_arithmetic_v<Args> && ...)) {
+            for (size_t idx = 0; idx < count; ++idx) {
+                if (!matches_arguments(std::index_sequence_for<Args...>(), args[idx]...)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void refresh() noexcept {
+        if (m_generation != m_runtime->generation()) {
+            resolve();
+        }
+    }
+
+    void resolve() noexcept {
+        m_generation = m_runtime->generation();
+        m_fn = nullptr;
+        m_arg_types = nullptr;
+
+        const auto fn_info = m_runtime->find_function_definition(m_name);
+        if (!fn_info) {
+            return;
+        }
+
+        const auto& signature = fn_info->prototype.signature;
+        if (signature.num_arg_types != sizeof...(Args)) {
+            return;
+        }
+
+        // Struct arguments can only be fully validated against an instance, so
+        // only their category is checked here.
+        if constexpr (sizeof...(Args) > 0) {
+            const MunTypeInfo* const* arg_ptr = signature.arg_types;
+            const bool arg_type_diffs[] = {
+                reflection::equals_return_type<Args>(**(arg_ptr++)).has_value()...};
+            for (const auto diff : arg_type_diffs) {
+                if (diff) {
+                    return;
+                }
+            }
+        }
+
+        if (signature.return_type) {
+            if (reflection::equals_return_type<Output>(*signature.return_type)) {
+                return;
+            }
+        } else if (!reflection::equal_types<void, Output>()) {
+            return;
+        }
+
+        m_arg_types = signature.arg_types;
+        m_fn = reinterpret_cast<fn_type>(const_cast<void*>(fn_info->fn_ptr));
+    }
+
+    template <typename Arg>
+    static bool matches_argument(const MunTypeInfo& type_info, const Arg& arg) noexcept {
+        if constexpr (std::is_arithmetic_v<Arg>) {
+            // Primitive arguments were validated upon resolving the function.
+            return true;
+        } else {
+            return !reflection::equals_argument_type(type_info, arg);
+        }
+    }
+
+    template <std::size_t... Is>
+    bool matches_arguments(std::index_sequence<Is...>, const Args&... args) const noexcept {
+        return (matches_argument(*m_arg_types[Is], args) && ...);
+    }
+
+    Runtime* m_runtime;
+    std::string m_name;
+    fn_type m_fn = nullptr;
+    const MunTypeInfo* const* m_arg_types = nullptr;
+    uint64_t m_generation = 0;
+};
+}  // namespace mun
+
+#endif
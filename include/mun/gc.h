@@ -1,7 +1,11 @@
 #ifndef MUN_GC_H_
 #define MUN_GC_H_
 
+#include <atomic>
+#include <cstddef>
+#include <new>
 #include <optional>
+#include <utility>
 
 #include "mun/error.h"
 
@@ -65,6 +69,13 @@ class GcRootPtr {
      */
     MunGcPtr handle() const noexcept { return m_ptr; }
 
+    /** Releases ownership of the root without unrooting the underlying `GcPtr`,
+     * returning the underlying garbage collection handle.
+     *
+     * \return a raw garbage collection handle
+     */
+    MunGcPtr release() noexcept { return std::exchange(m_ptr, nullptr); }
+
     /** Unroots the underlying `GcPtr`, returning the underlying garbage
      * collection handle.
      *
@@ -83,6 +94,115 @@ class GcRootPtr {
     MunGcPtr m_ptr;
     const Runtime* m_runtime;
 };
+
+namespace details {
+/** The shared state of a `SharedGcRoot`. */
+struct SharedGcRootBlock {
+    std::atomic<size_t> ref_count;
+    MunGcPtr ptr;
+    const Runtime* runtime;
+};
+}  // namespace details
+
+/** A rooted garbage collection pointer that is shared by reference counting.
+ *
+ * All copies share a single runtime root, which is released when the last
+ * copy is destroyed. Copying only increments an atomic reference count, so it
+ * does not call into the runtime.
+ *
+ * The runtime owns the memory of the root, so the reference count is kept in
+ * a control block that is allocated once per shared root. If that allocation
+ * fails, the pointer is empty; i.e. `handle` returns null.
+ */
+class SharedGcRoot {
+   public:
+    /** Constructs a shared garbage collection pointer, rooting the provided
+     * raw garbage collection handle.
+     *
+     * \param runtime a reference to a runtime
+     * \param obj a garbage collected object handle
+     */
+    SharedGcRoot(const Runtime& runtime, MunGcPtr obj) noexcept
+        : m_block(new (std::nothrow) details::SharedGcRootBlock{{1}, obj, &runtime}) {
+        if (m_block) {
+            runtime.gc_root_ptr(obj);
+        }
+    }
+
+    /** Constructs a shared garbage collection pointer that takes over the root
+     * of `root`, without rooting the object again.
+     *
+     * If the control block cannot be allocated, `root` keeps its root.
+     *
+     * \param runtime a reference to the runtime of `root`
+     * \param root an rvalue reference to a `GcRootPtr`
+     */
+    SharedGcRoot(const Runtime& runtime, GcRootPtr&& root) noexcept
+        : m_block(new (std::nothrow) details::SharedGcRootBlock{{1}, root.handle(), &runtime}) {
+        if (m_block) {
+            root.release();
+        }
+    }
+
+    /** Copy constructs a `SharedGcRoot`, sharing the root of `other`.
+     *
+     * \param other a reference to another `SharedGcRoot`
+     */
+    SharedGcRoot(const SharedGcRoot& other) noexcept : m_block(other.m_block) {
+        if (m_block) {
+            m_block->ref_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /** Move constructs a `SharedGcRoot`
+     *
+     * \param other an rvalue reference to a `SharedGcRoot`
+     */
+    SharedGcRoot(SharedGcRoot&& other) noexcept : m_block(std::exchange(other.m_block, nullptr)) {}
+
+    /** Copy assignment operator for `SharedGcRoot`
+     *
+     * \param other a reference to another `SharedGcRoot`
+     * \return a reference this instance
+     */
+    SharedGcRoot& operator=(const SharedGcRoot& other) noexcept {
+        return *this = SharedGcRoot(other);
+    }
+
+    /** Move assignment operator for `SharedGcRoot`
+     *
+     * \param other an rvalue reference to a `SharedGcRoot`
+     * \return a reference this instance
+     */
+    SharedGcRoot& operator=(SharedGcRoot&& other) noexcept {
+        std::swap(m_block, other.m_block);
+        return *this;
+    }
+
+    /** Destructs the `SharedGcRoot`, unrooting the underlying `GcPtr` if this
+     * is the last copy.
+     */
+    ~SharedGcRoot() noexcept {
+        if (m_block && m_block->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            m_block->runtime->gc_unroot_ptr(m_block->ptr);
+            delete m_block;
+        }
+    }
+
+    /** Retrieves the raw garbage collection handle of this instance.
+     *
+     * \return a raw garbage collection handle
+     */
+    MunGcPtr handle() const noexcept { return m_block ? m_block->ptr : nullptr; }
+
+    /** Retrieves the number of copies that share the root. */
+    size_t use_count() const noexcept {
+        return m_block ? m_block->ref_count.load(std::memory_order_relaxed) : 0;
+    }
+
+   private:
+    details::SharedGcRootBlock* m_block;
+};
 }  // namespace mun
 
 #endif
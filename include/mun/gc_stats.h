@@ -0,0 +1,270 @@
+#ifndef MUN_GC_STATS_H_
+#define MUN_GC_STATS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mun/runtime_capi.h"
+
+namespace mun {
+/** Allocation statistics of a single type. */
+struct GcTypeStats {
+    /** The name of the type. */
+    std::string type_name;
+
+    /** The number of allocated objects. */
+    uint64_t num_allocations = 0;
+
+    /** The number of allocated bytes. */
+    uint64_t bytes_allocated = 0;
+};
+
+/** Garbage collection statistics of a runtime.
+ *
+ * The runtime's C API does not expose its heap, so the statistics only cover
+ * the operations performed through the `Runtime`: objects allocated by Mun
+ * functions themselves are not counted, and neither are the bytes that a
+ * collection reclaims.
+ */
+struct GcStats {
+    /** The number of objects allocated through `gc_alloc` and `gc_alloc_many`. */
+    uint64_t num_allocations = 0;
+
+    /** The number of bytes allocated through `gc_alloc` and `gc_alloc_many`. */
+    uint64_t bytes_allocated = 0;
+
+    /** The number of bytes allocated through `gc_alloc` and `gc_alloc_many`
+     * since the last garbage collection.
+     */
+    uint64_t bytes_allocated_since_collection = 0;
+
+    /** The allocation statistics per type, in order of first allocation.
+     * Types that were reloaded are identified by name.
+     *
+     * Only recorded if `RuntimeOptions::gc_type_stats` is set, as it requires
+     * a lock on every allocation.
+     */
+    std::vector<GcTypeStats> types;
+
+    /** The number of roots currently held through the runtime, including
+     * those of `GcRootPtr`s, `StructRef`s and `RootSet`s.
+     */
+    int64_t num_roots = 0;
+
+    /** The number of garbage collections, excluding those skipped within a
+     * `GcNoCollectScope`.
+     */
+    uint64_t num_collections = 0;
+
+    /** The number of garbage collections that reclaimed memory. */
+    uint64_t num_reclaiming_collections = 0;
+
+    /** The total duration of all garbage collections. */
+    std::chrono::nanoseconds total_collection_time{0};
+
+    /** The duration of the most recent garbage collection. */
+    std::chrono::nanoseconds last_collection_time{0};
+};
+
+namespace details {
+/** The conditions under which a runtime collects garbage automatically. */
+struct GcPolicy {
+    /** The number of bytes allocated through the runtime since the last
+     * collection that triggers a collection, or `0` to disable automatic
+     * collection.
+     */
+    uint64_t collect_after_alloc_bytes = 0;
+
+    /** The factor by which the heap may grow relative to the estimated
+     * survivors of a collection, before the next collection is triggered.
+     */
+    double heap_growth_factor = 2.0;
+
+    /** The longest expected collection that is performed before the hard
+     * limit of twice the trigger is reached, or `0` for no limit.
+     */
+    std::chrono::microseconds max_pause{0};
+
+    /** Whether `Runtime::update` collects garbage if needed. */
+    bool collect_on_update = false;
+};
+
+/** Records the garbage collection statistics of a runtime.
+ *
+ * Roots and allocations are counted atomically, as they are recorded on every
+ * `StructRef` copy and marshalled struct; the statistics per type and of
+ * collections are recorded under a lock.
+ */
+class GcStatsRecorder {
+   public:
+    GcStatsRecorder() noexcept = default;
+
+    GcStatsRecorder(const GcStatsRecorder&) = delete;
+    GcStatsRecorder& operator=(const GcStatsRecorder&) = delete;
+
+    /** Sets whether allocations are recorded per type. Must be called before
+     * the recorder is shared between threads.
+     */
+    void set_record_types(bool record_types) noexcept { m_record_types = record_types; }
+
+    /** Sets the conditions under which garbage is collected automatically. */
+    void set_policy(const GcPolicy& policy) noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_policy = policy;
+        m_collection_threshold = policy.collect_after_alloc_bytes;
+    }
+
+    /** Retrieves whether garbage is collected automatically. */
+    bool has_policy() const noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_policy.collect_after_alloc_bytes > 0;
+    }
+
+    /** Retrieves whether the allocations since the last collection crossed
+     * the thresholds of the policy.
+     */
+    bool needs_collection() const noexcept {
+        const auto allocated = m_bytes_allocated_since_collection.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_policy.collect_after_alloc_bytes == 0 || allocated < m_collection_threshold) {
+            return false;
+        }
+
+        // Defer long collections until the hard limit is reached
+        const auto max_pause = m_policy.max_pause;
+        return max_pause.count() == 0 || allocated >= 2 * m_collection_threshold ||
+               expected_collection_time_locked() <= max_pause;
+    }
+
+    /** Records `count` allocations of objects of type `type_info`. */
+    void record_allocations(const MunTypeInfo& type_info, uint64_t count) noexcept {
+        if (count == 0) {
+            return;
+        }
+
+        const auto bytes = count * ((type_info.size_in_bits + 7) / 8);
+        m_num_allocations.fetch_add(count, std::memory_order_relaxed);
+        m_bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+        m_bytes_allocated_since_collection.fetch_add(bytes, std::memory_order_relaxed);
+        if (!m_record_types) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto [it, inserted] = m_type_slots.try_emplace(&type_info, m_stats.types.size());
+        if (inserted) {
+            // A type that was reloaded keeps its statistics
+            auto& types = m_stats.types;
+            const auto existing =
+                std::find_if(types.begin(), types.end(), [&](const GcTypeStats& stats) {
+                    return stats.type_name == type_info.name;
+                });
+            if (existing == types.end()) {
+                types.push_back(GcTypeStats{type_info.name});
+            } else {
+                it->second = static_cast<size_t>(existing - types.begin());
+            }
+        }
+
+        auto& stats = m_stats.types[it->second];
+        stats.num_allocations += count;
+        stats.bytes_allocated += bytes;
+    }
+
+    /** Records that `delta` roots were added, or removed if negative. */
+    void record_roots(int64_t delta) noexcept {
+        m_num_roots.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /** Records a garbage collection that took `duration`. */
+    void record_collection(std::chrono::nanoseconds duration, bool reclaimed) noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.num_collections;
+        m_stats.num_reclaiming_collections += reclaimed ? 1 : 0;
+        m_stats.total_collection_time += duration;
+        m_stats.last_collection_time = duration;
+        m_average_collection_time = m_stats.num_collections == 1
+                                        ? duration
+                                        : (3 * m_average_collection_time + duration) / 4;
+
+        m_bytes_allocated_since_collection.store(0, std::memory_order_relaxed);
+
+        // The heap is allowed to grow in proportion to the objects that
+        // survived, which prevents back-to-back collections of a live heap.
+        const auto growth = static_cast<uint64_t>(static_cast<double>(estimated_survivor_bytes()) *
+                                                  std::max(m_policy.heap_growth_factor - 1, 0.0));
+        m_collection_threshold = std::max(m_policy.collect_after_alloc_bytes, growth);
+    }
+
+    /** Predicts the duration of the next garbage collection from the previous
+     * ones, or returns zero if there were none.
+     */
+    std::chrono::nanoseconds expected_collection_time() const noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return expected_collection_time_locked();
+    }
+
+    /** Forgets the addresses of types, which a reload can invalidate. */
+    void forget_types() noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_type_slots.clear();
+    }
+
+    /** Retrieves a copy of the recorded statistics. */
+    GcStats snapshot() const noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        GcStats stats = m_stats;
+        stats.num_allocations = m_num_allocations.load(std::memory_order_relaxed);
+        stats.bytes_allocated = m_bytes_allocated.load(std::memory_order_relaxed);
+        stats.bytes_allocated_since_collection =
+            m_bytes_allocated_since_collection.load(std::memory_order_relaxed);
+        stats.num_roots = m_num_roots.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+   private:
+    /** Estimates the number of bytes that survive a collection.
+     *
+     * The runtime does not report the size of its heap, so this assumes that
+     * every root held through the runtime keeps an object of the average size
+     * allocated through it alive.
+     */
+    uint64_t estimated_survivor_bytes() const noexcept {
+        const auto num_allocations = m_num_allocations.load(std::memory_order_relaxed);
+        const auto num_roots = m_num_roots.load(std::memory_order_relaxed);
+        if (num_allocations == 0 || num_roots <= 0) {
+            return 0;
+        }
+        return static_cast<uint64_t>(num_roots) *
+               (m_bytes_allocated.load(std::memory_order_relaxed) / num_allocations);
+    }
+
+    std::chrono::nanoseconds expected_collection_time_locked() const noexcept {
+        // The heap tends to grow, so the most recent collection is a lower
+        // bound.
+        return std::max(m_average_collection_time, m_stats.last_collection_time);
+    }
+
+    std::atomic<int64_t> m_num_roots{0};
+    std::atomic<uint64_t> m_num_allocations{0};
+    std::atomic<uint64_t> m_bytes_allocated{0};
+    std::atomic<uint64_t> m_bytes_allocated_since_collection{0};
+    bool m_record_types = false;
+    GcStats m_stats;
+    std::chrono::nanoseconds m_average_collection_time{0};
+    GcPolicy m_policy;
+    uint64_t m_collection_threshold = 0;
+    std::unordered_map<const MunTypeInfo*, size_t> m_type_slots;
+    mutable std::mutex m_mutex;
+};
+}  // namespace details
+}  // namespace mun
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef MUN_INVOKE_ASYNC_H_
+#define MUN_INVOKE_ASYNC_H_
+
+#include <future>
+#include <memory>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "mun/invoke_fn.h"
+#include "mun/invoke_result.h"
+#include "mun/runtime.h"
+
+namespace mun {
+namespace details {
+template <typename Output, typename... Args>
+void fulfill(std::promise<Output>& promise, InvokeResult<Output, Args...>& result) noexcept {
+    if constexpr (std::is_void_v<Output>) {
+        promise.set_value();
+    } else {
+        promise.set_value(result.unwrap());
+    }
+}
+
+/** A failed function invocation that is retried every time the runtime
+ * reloads, until it succeeds.
+ */
+template <typename Output, typename... Args>
+class AsyncInvocation final : public UpdateListener {
+   public:
+    AsyncInvocation(std::promise<Output> promise, InvokeFailure<Args...> failure) noexcept
+        : m_promise(std::move(promise)), m_failure(std::move(failure)) {}
+
+    bool on_update() noexcept override {
+        auto result = std::apply(
+            [this](Args&... args) {
+                return invoke_fn<Output, Args...>(*m_failure.runtime, m_failure.fn_name.view(),
+                                                  std::move(args)...);
+            },
+            m_failure.args);
+
+        if (result.is_err()) {
+            m_failure = result.unwrap_err();
+            return false;
+        }
+
+        fulfill(m_promise, result);
+        return true;
+    }
+
+   private:
+    std::promise<Output> m_promise;
+    InvokeFailure<Args...> m_failure;
+};
+}  // namespace details
+
+/** Converts an invocation result into a future.
+ *
+ * On success, the future is ready immediately. Otherwise, the invocation is
+ * retried on the thread that calls `Runtime::update`, every time the runtime
+ * reloads, until it succeeds. If the runtime is destroyed first, the future
+ * reports a broken promise.
+ *
+ * \param result an invocation result
+ * \return a future that receives the function's output
+ */
+template <typename Output, typename... Args>
+std::future<Output> to_future(InvokeResult<Output, Args...>&& result) noexcept {
+    std::promise<Output> promise;
+    auto future = promise.get_future();
+    if (result.is_ok()) {
+        details::fulfill(promise, result);
+    } else {
+        auto failure = result.unwrap_err();
+        auto& runtime = *failure.runtime;
+        runtime.add_update_listener(std::make_unique<details::AsyncInvocation<Output, Args...>>(
+            std::move(promise), std::move(failure)));
+    }
+    return future;
+}
+
+/** Invokes the runtime function corresponding to `fn_name` with arguments
+ * `args`, without blocking if the invocation fails.
+ *
+ * See `to_future` for how failed invocations are completed.
+ *
+ * \param runtime the runtime
+ * \param fn_name the name of the desired function
+ * \param args zero or more arguments to supply to the function invocation
+ * \return a future that receives the function's output
+ */
+template <typename Output, typename... Args>
+std::future<Output> invoke_async(Runtime& runtime, std::string_view fn_name,
+                                 Args... args) noexcept {
+    return to_future(invoke_fn<Output, Args...>(runtime, fn_name, std::move(args)...));
+}
+}  // namespace mun
+
+#endif
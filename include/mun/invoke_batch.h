@@ -0,0 +1,92 @@
+#ifndef MUN_INVOKE_BATCH_H_
+#define MUN_INVOKE_BATCH_H_
+
+#include <string_view>
+#include <type_traits>
+
+#include "mun/function_handle.h"
+#include "mun/runtime.h"
+#include "mun/span.h"
+#include "mun/thread_pool.h"
+
+namespace mun {
+/** Invokes the runtime function corresponding to `fn_name` once for every
+ * element of the `args` spans, writing the outputs to `out`.
+ *
+ * The function is looked up and validated once, after which it is called
+ * directly for every element. Only default constructible outputs can be
+ * batched; see `Function::invoke_batch`.
+ *
+ * \param runtime the runtime
+ * \param fn_name the name of the desired function
+ * \param out a span that receives the outputs
+ * \param args a span per argument, each the same size as `out`
+ * \return whether the function was invoked
+ */
+template <typename Output, typename... Args>
+std::enable_if_t<details::is_batch_output_v<Output>, bool> invoke_batch(
+    Runtime& runtime, std::string_view fn_name, Span<Output> out,
+    Span<const Args>... args) noexcept {
+    return Function<Output(Args...)>(runtime, fn_name).invoke_batch(out, args...);
+}
+
+/** Invokes the runtime function corresponding to `fn_name` once for every
+ * element of the `args` spans.
+ *
+ * The function is looked up and validated once, after which it is called
+ * directly for every element.
+ *
+ * \param runtime the runtime
+ * \param fn_name the name of the desired function
+ * \param args a span per argument, all of the same size
+ * \return whether the function was invoked
+ */
+template <typename Output, typename... Args>
+std::enable_if_t<std::is_void_v<Output>, bool> invoke_batch(Runtime& runtime,
+                                                            std::string_view fn_name,
+                                                            Span<const Args>... args) noexcept {
+    return Function<Output(Args...)>(runtime, fn_name).invoke_batch(args...);
+}
+
+/** Invokes the pure runtime function corresponding to `fn_name` once for every
+ * element of the `args` spans, spread across the threads of `pool`, writing
+ * the outputs to `out`.
+ *
+ * The function is looked up and validated once on the calling thread. See
+ * `Runtime` for the operations that are allowed to run concurrently.
+ *
+ * \param pool the thread pool to run the invocations on
+ * \param runtime the runtime
+ * \param fn_name the name of the desired function
+ * \param out a span that receives the outputs
+ * \param args a span per argument, each the same size as `out`
+ * \return whether the function was invoked
+ */
+template <typename Output, typename... Args>
+std::enable_if_t<details::is_batch_output_v<Output>, bool> invoke_parallel(
+    ThreadPool& pool, Runtime& runtime, std::string_view fn_name, Span<Output> out,
+    Span<const Args>... args) noexcept {
+    return Function<Output(Args...)>(runtime, fn_name).invoke_parallel(pool, out, args...);
+}
+
+/** Invokes the pure runtime function corresponding to `fn_name` once for every
+ * element of the `args` spans, spread across the threads of `pool`.
+ *
+ * The function is looked up and validated once on the calling thread. See
+ * `Runtime` for the operations that are allowed to run concurrently.
+ *
+ * \param pool the thread pool to run the invocations on
+ * \param runtime the runtime
+ * \param fn_name the name of the desired function
+ * \param args a span per argument, all of the same size
+ * \return whether the function was invoked
+ */
+template <typename Output, typename... Args>
+std::enable_if_t<std::is_void_v<Output>, bool> invoke_parallel(ThreadPool& pool, Runtime& runtime,
+                                                               std::string_view fn_name,
+                                                               Span<const Args>... args) noexcept {
+    return Function<Output(Args...)>(runtime, fn_name).invoke_parallel(pool, args...);
+}
+}  // namespace mun
+
+#endif
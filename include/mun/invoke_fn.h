@@ -1,10 +1,11 @@
 #ifndef MUN_INVOKE_FN_H_
 #define MUN_INVOKE_FN_H_
 
-#include <iostream>
 #include <optional>
 #include <string_view>
+#include <tuple>
 
+#include "mun/diagnostics.h"
 #include "mun/invoke_result.h"
 #include "mun/marshal.h"
 #include "mun/reflection.h"
@@ -15,6 +16,9 @@ namespace mun {
 /** Invokes the runtime function corresponding to `fn_name` with arguments
  * `args`.
  *
+ * On failure, the reason is reported to the runtime's diagnostic sink and
+ * stored in the returned result.
+ *
  * \param runtime the runtime
  * \param fn_name the name of the desired function
  * \param args zero or more arguments to supply to the function invocation
@@ -23,30 +27,32 @@ namespace mun {
 template <typename Output, typename... Args>
 InvokeResult<Output, Args...> invoke_fn(Runtime& runtime, std::string_view fn_name,
                                         Args... args) noexcept {
-    auto make_error = [](Runtime& runtime, std::string_view fn_name, Args... args) {
-        return InvokeResult<Output, Args...>(
-            [&runtime, fn_name](Args... fn_args) {
-                return invoke_fn<Output, Args...>(runtime, fn_name, fn_args...);
-            },
-            [&runtime]() { return runtime.update(); }, std::move(args)...);
+    auto make_error = [](Runtime& runtime, std::string_view fn_name, InvokeError error,
+                         Args... args) {
+        runtime.report(fn_name, error);
+        return InvokeResult<Output, Args...>(runtime, fn_name, std::move(error),
+                                             std::move(args)...);
     };
 
     Error error;
     constexpr auto NUM_ARGS = sizeof...(Args);
     if (auto fn_info = runtime.find_function_definition(fn_name, &error); error) {
-        std::cerr << "Failed to retrieve function info due to error: " << error.message()
-                  << std::endl;
+        InvokeError invoke_error{InvokeErrorKind::LookupFailed};
+        if (const auto message = error.message()) {
+            invoke_error.message = message;
+        }
+        return make_error(runtime, fn_name, std::move(invoke_error), std::move(args)...);
     } else if (!fn_info) {
-        std::cerr << "Failed to obtain function '" << fn_name << "'" << std::endl;
+        return make_error(runtime, fn_name, InvokeError{InvokeErrorKind::FunctionNotFound},
+                          std::move(args)...);
     } else {
         const auto& prototype = fn_info->prototype;
         const auto& signature = prototype.signature;
         if (signature.num_arg_types != NUM_ARGS) {
-            std::cerr << "Invalid number of arguments. Expected: "
-                      << std::to_string(signature.num_arg_types)
-                      << ". Found: " << std::to_string(NUM_ARGS) << "." << std::endl;
-
-            return make_error(runtime, fn_name, args...);
+            InvokeError invoke_error{InvokeErrorKind::ArgumentCountMismatch};
+            invoke_error.expected_num_args = signature.num_arg_types;
+            invoke_error.found_num_args = static_cast<uint16_t>(NUM_ARGS);
+            return make_error(runtime, fn_name, invoke_error, std::move(args)...);
         }
 
         if constexpr (NUM_ARGS > 0) {
@@ -56,12 +62,10 @@ InvokeResult<Output, Args...> invoke_fn(Runtime& runtime, std::string_view fn_na
 
             for (size_t idx = 0; idx < NUM_ARGS; ++idx) {
                 if (auto diff = return_type_diffs[idx]) {
-                    const auto& [expected, found] = *diff;
-                    std::cerr << "Invalid argument type at index " << idx
-                              << ". Expected: " << expected << ". Found: " << found << "."
-                              << std::endl;
-
-                    return make_error(runtime, fn_name, args...);
+                    InvokeError invoke_error{InvokeErrorKind::ArgumentTypeMismatch};
+                    invoke_error.arg_index = static_cast<uint16_t>(idx);
+                    std::tie(invoke_error.expected_type, invoke_error.found_type) = *diff;
+                    return make_error(runtime, fn_name, invoke_error, std::move(args)...);
                 }
             }
         }
@@ -69,19 +73,15 @@ InvokeResult<Output, Args...> invoke_fn(Runtime& runtime, std::string_view fn_na
         if (signature.return_type) {
             const auto& return_type = signature.return_type;
             if (auto diff = reflection::equals_return_type<Output>(*return_type)) {
-                const auto& [expected, found] = *diff;
-                std::cerr << "Invalid return type. Expected: " << expected << ". Found: " << found
-                          << "." << std::endl;
-
-                return make_error(runtime, fn_name, args...);
+                InvokeError invoke_error{InvokeErrorKind::ReturnTypeMismatch};
+                std::tie(invoke_error.expected_type, invoke_error.found_type) = *diff;
+                return make_error(runtime, fn_name, invoke_error, std::move(args)...);
             }
         } else if (!reflection::equal_types<void, Output>()) {
-            std::cerr << "Invalid return type. Expected: "
-                      << ReturnTypeReflection<void>::type_name()
-                      << ". Found: " << ReturnTypeReflection<Output>::type_name() << "."
-                      << std::endl;
-
-            return make_error(runtime, fn_name, args...);
+            InvokeError invoke_error{InvokeErrorKind::ReturnTypeMismatch};
+            invoke_error.expected_type = ReturnTypeReflection<void>::type_name();
+            invoke_error.found_type = ReturnTypeReflection<Output>::type_name();
+            return make_error(runtime, fn_name, invoke_error, std::move(args)...);
         }
 
         auto fn = reinterpret_cast<typename Marshal<Output>::type(MUN_CALLTYPE*)(
@@ -94,8 +94,6 @@ InvokeResult<Output, Args...> invoke_fn(Runtime& runtime, std::string_view fn_na
                 Marshal<Output>::from(fn(Marshal<Args>::to(args)...), runtime));
         }
     }
-
-    return make_error(runtime, fn_name, args...);
 }
 }  // namespace mun
 
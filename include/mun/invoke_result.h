@@ -1,23 +1,83 @@
 #ifndef MUN_RESULT_H_
 #define MUN_RESULT_H_
 
-#include <chrono>
-#include <functional>
+#include <cstring>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <tuple>
+#include <utility>
 #include <variant>
 
+#include "mun/diagnostics.h"
+#include "mun/runtime.h"
+
 namespace mun {
+template <typename Output, typename... Args>
+class InvokeResult;
+
+template <typename Output, typename... Args>
+InvokeResult<Output, Args...> invoke_fn(Runtime& runtime, std::string_view fn_name,
+                                        Args... args) noexcept;
+
+namespace details {
+/** A null-terminated function name that is stored inline, unless it exceeds
+ * the inline capacity.
+ */
+class FunctionName {
+    static constexpr size_t INLINE_CAPACITY = 55;
+
+   public:
+    /** Constructs a function name by copying `name`.
+     *
+     * \param name a function name
+     */
+    explicit FunctionName(std::string_view name) noexcept : m_size(name.size()) {
+        if (m_size <= INLINE_CAPACITY) {
+            std::memcpy(m_inline, name.data(), m_size);
+            m_inline[m_size] = '\0';
+        } else {
+            m_heap.assign(name);
+        }
+    }
+
+    /** Retrieves a view of the function name, which is null-terminated. */
+    std::string_view view() const noexcept {
+        return m_size <= INLINE_CAPACITY ? std::string_view(m_inline, m_size)
+                                         : std::string_view(m_heap);
+    }
+
+   private:
+    char m_inline[INLINE_CAPACITY + 1];
+    size_t m_size;
+    std::string m_heap;
+};
+
+/** The state of a failed function invocation that is required to retry it. */
+template <typename... Args>
+struct InvokeFailure {
+    /** The runtime in which the function was invoked. */
+    Runtime* runtime;
+
+    /** The name of the invoked function. */
+    FunctionName fn_name;
+
+    /** The arguments of the invocation. */
+    std::tuple<Args...> args;
+
+    /** The reason the invocation failed. */
+    InvokeError error;
+};
+}  // namespace details
+
 /** A variant that stores either the successful output of a function invocation
- * or the error state (i.e. callbacks and arguments) necessary to retry.
+ * or the error state (i.e. function identity and arguments) necessary to retry.
  */
 template <typename Output, typename... Args>
 class InvokeResult {
     using result_type = InvokeResult<Output, Args...>;
     using success_type = Output;
-    using retry_fn_type = std::function<result_type(Args...)>;
-    using update_fn_type = std::function<bool()>;
-    using args_type = std::tuple<Args...>;
-    using error_type = std::tuple<retry_fn_type, update_fn_type, args_type>;
+    using error_type = details::InvokeFailure<Args...>;
 
    public:
     /** Constructs a result from the output of a successful function invocation.
@@ -26,16 +86,19 @@ class InvokeResult {
      */
     explicit InvokeResult(success_type &&success) : m_variant(std::move(success)) {}
 
-    /** Constructs a result from a retry callback, its arguments, and an update
-     * callback.
+    /** Constructs a result from a failed function invocation.
      *
-     * \param retry_fn a retry callback
-     * \param update_fn an update callback
-     * \param args arguments for the retry_fn
+     * \param runtime the runtime in which the function was invoked
+     * \param fn_name the name of the invoked function
+     * \param error the reason the invocation failed
+     * \param args arguments of the invocation
      */
-    explicit InvokeResult(retry_fn_type &&retry_fn, update_fn_type &&update_fn, Args &&... args)
-        : m_variant(std::tuple(std::move(retry_fn), std::move(update_fn),
-                               std::tuple(std::forward<Args>(args)...))) {}
+    explicit InvokeResult(Runtime &runtime, std::string_view fn_name, InvokeError error,
+                          Args &&... args)
+        : m_variant(std::in_place_type<error_type>,
+                    error_type{&runtime, details::FunctionName(fn_name),
+                               std::tuple<Args...>(std::forward<Args>(args)...),
+                               std::move(error)}) {}
 
     /** Retrieves whether the function invocation succeeded. */
     bool is_ok() noexcept { return std::holds_alternative<success_type>(m_variant); }
@@ -61,16 +124,27 @@ class InvokeResult {
      */
     error_type &&unwrap_err() noexcept { return std::move(std::get<1>(m_variant)); }
 
+    /** Retrieves the reason that the function invocation failed.
+     *
+     * BEWARE: Calling this on a successful invocation result will result in
+     * undefined behavior.
+     *
+     * \return the invocation error
+     */
+    const InvokeError &error() const noexcept { return std::get<1>(m_variant).error; }
+
     /** Retries a failed function invocation and returns the result, or
      * immediately returns on prior success.
      *
-     * This will wait on updates from the `update_fn` callback before retrying.
+     * This will wait on updates of the runtime before retrying. A failed update
+     * is attempted again after `Runtime::update_poll_interval`. While waiting,
+     * the calling thread is in a safe region; see `Runtime::wait_for_update`.
      *
      * \return the result of a retried function invocation
      */
-    result_type &&retry() noexcept {
+    result_type retry() noexcept {
         if (is_err()) {
-            return std::move(retry_impl(std::make_index_sequence<sizeof...(Args)>()));
+            return retry_impl(std::make_index_sequence<sizeof...(Args)>());
         } else {
             return std::move(*this);
         }
@@ -86,7 +160,7 @@ class InvokeResult {
      */
     success_type &&wait() noexcept {
         while (is_err()) {
-            *this = std::move(retry_impl(std::make_index_sequence<sizeof...(Args)>()));
+            *this = retry_impl(std::make_index_sequence<sizeof...(Args)>());
         }
         return unwrap();
     }
@@ -94,30 +168,26 @@ class InvokeResult {
    private:
     template <std::size_t... Is>
     result_type retry_impl(std::index_sequence<Is...>) {
-        auto err = std::move(unwrap_err());
-        auto &retry_fn = std::get<0>(err);
-        auto &update_fn = std::get<1>(err);
-        auto &args = std::get<2>(err);
-        while (!update_fn()) {
-            // TODO: Expose a Runtime API to wait for updates
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        auto err = unwrap_err();
+        while (!err.runtime->wait_for_update()) {
+            // The update failed, so back off before trying again.
+            Safepoint safepoint(*err.runtime);
+            std::this_thread::sleep_for(err.runtime->update_poll_interval());
         }
-        return retry_fn(std::get<Is>(args)...);
+        return invoke_fn<Output, Args...>(*err.runtime, err.fn_name.view(),
+                                          std::move(std::get<Is>(err.args))...);
     }
 
     std::variant<success_type, error_type> m_variant;
 };
 
 /** A variant that stores either the successful output of a function invocation
- * or the error state (i.e. callbacks and arguments) necessary to retry.
+ * or the error state (i.e. function identity and arguments) necessary to retry.
  */
 template <typename... Args>
 class InvokeResult<void, Args...> {
     using result_type = InvokeResult<void, Args...>;
-    using retry_fn_type = std::function<result_type(Args...)>;
-    using update_fn_type = std::function<bool()>;
-    using args_type = std::tuple<Args...>;
-    using error_type = std::tuple<retry_fn_type, update_fn_type, args_type>;
+    using error_type = details::InvokeFailure<Args...>;
 
    public:
     /** Constructs a result from the output of a successful function invocation.
@@ -126,16 +196,19 @@ class InvokeResult<void, Args...> {
      */
     explicit InvokeResult(std::monostate monostate) : m_variant(std::move(monostate)) {}
 
-    /** Constructs a result from a retry callback, its arguments, and an update
-     * callback.
+    /** Constructs a result from a failed function invocation.
      *
-     * \param retry_fn a retry callback
-     * \param update_fn an update callback
-     * \param args arguments for the retry_fn
+     * \param runtime the runtime in which the function was invoked
+     * \param fn_name the name of the invoked function
+     * \param error the reason the invocation failed
+     * \param args arguments of the invocation
      */
-    explicit InvokeResult(retry_fn_type &&retry_fn, update_fn_type &&update_fn, Args &&... args)
-        : m_variant(std::tuple(std::move(retry_fn), std::move(update_fn),
-                               std::tuple(std::forward<Args>(args)...))) {}
+    explicit InvokeResult(Runtime &runtime, std::string_view fn_name, InvokeError error,
+                          Args &&... args)
+        : m_variant(std::in_place_type<error_type>,
+                    error_type{&runtime, details::FunctionName(fn_name),
+                               std::tuple<Args...>(std::forward<Args>(args)...),
+                               std::move(error)}) {}
 
     /** Retrieves whether the function invocation succeeded. */
     bool is_ok() noexcept { return std::holds_alternative<std::monostate>(m_variant); }
@@ -161,14 +234,25 @@ class InvokeResult<void, Args...> {
      */
     error_type &&unwrap_err() noexcept { return std::move(std::get<1>(m_variant)); }
 
+    /** Retrieves the reason that the function invocation failed.
+     *
+     * BEWARE: Calling this on a successful invocation result will result in
+     * undefined behavior.
+     *
+     * \return the invocation error
+     */
+    const InvokeError &error() const noexcept { return std::get<1>(m_variant).error; }
+
     /** Retries a failed function invocation and returns the result, or
      * immediately returns on prior success.
      *
-     * This will wait on updates from the `update_fn` callback before retrying.
+     * This will wait on updates of the runtime before retrying. A failed update
+     * is attempted again after `Runtime::update_poll_interval`. While waiting,
+     * the calling thread is in a safe region; see `Runtime::wait_for_update`.
      *
      * \return the result of a retried function invocation
      */
-    result_type &&retry() noexcept {
+    result_type retry() noexcept {
         if (is_err()) {
             return retry_impl(std::make_index_sequence<sizeof...(Args)>());
         } else {
@@ -186,22 +270,21 @@ class InvokeResult<void, Args...> {
      */
     void wait() noexcept {
         while (is_err()) {
-            *this = std::move(retry_impl(std::make_index_sequence<sizeof...(Args)>()));
+            *this = retry_impl(std::make_index_sequence<sizeof...(Args)>());
         }
     }
 
    private:
     template <std::size_t... Is>
     result_type retry_impl(std::index_sequence<Is...>) {
-        auto err = std::move(unwrap_err());
-        auto &retry_fn = std::get<0>(err);
-        auto &update_fn = std::get<1>(err);
-        auto &args = std::get<2>(err);
-        while (!update_fn()) {
-            // TODO: Expose a Runtime API to wait for updates
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        auto err = unwrap_err();
+        while (!err.runtime->wait_for_update()) {
+            // The update failed, so back off before trying again.
+            Safepoint safepoint(*err.runtime);
+            std::this_thread::sleep_for(err.runtime->update_poll_interval());
         }
-        return retry_fn(std::get<Is>(args)...);
+        return invoke_fn<void, Args...>(*err.runtime, err.fn_name.view(),
+                                        std::move(std::get<Is>(err.args))...);
     }
 
     std::variant<std::monostate, error_type> m_variant;
@@ -2,8 +2,15 @@
 #define MUN_MUN_H_
 
 #include "mun/error.h"
+#include "mun/field_path.h"
+#include "mun/function_handle.h"
+#include "mun/invoke_async.h"
+#include "mun/invoke_batch.h"
 #include "mun/invoke_fn.h"
+#include "mun/root_set.h"
 #include "mun/runtime.h"
+#include "mun/struct_mirror.h"
 #include "mun/struct_ref.h"
+#include "mun/value_struct.h"
 
 #endif
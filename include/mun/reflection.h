@@ -5,11 +5,15 @@
 #include <cstdint>
 #include <iterator>
 #include <optional>
+#include <type_traits>
 
 #include "mun/runtime_capi.h"
 #include "mun/type_info.h"
 
 namespace mun {
+class StructView;
+class ValueStruct;
+
 constexpr inline bool operator==(const MunGuid& lhs, const MunGuid& rhs) noexcept {
     for (auto idx = 0; idx < 16; ++idx) {
         if (lhs._0[idx] != rhs._0[idx]) {
@@ -77,7 +81,11 @@ std::optional<std::pair<const char*, const char*>> equals_return_type(
         if (type_info.guid != ReturnTypeReflection<T>::type_guid()) {
             return std::make_pair(type_info.name, ReturnTypeReflection<T>::type_name());
         }
-    } else if (!reflection::equal_types<StructRef, T>()) {
+    } else if (!reflection::equal_types<StructRef, T>() ||
+               (std::is_same_v<T, ValueStruct> &&
+                type_info.data.struct_.memory_kind != MunStructMemoryKind::Value) ||
+               (std::is_same_v<T, StructView> &&
+                type_info.data.struct_.memory_kind != MunStructMemoryKind::Gc)) {
         return std::make_pair(type_info.name, ReturnTypeReflection<T>::type_name());
     }
 
@@ -0,0 +1,139 @@
+#ifndef MUN_ROOT_SET_H_
+#define MUN_ROOT_SET_H_
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "mun/error.h"
+#include "mun/runtime.h"
+#include "mun/span.h"
+
+namespace mun {
+/** A container of rooted garbage collection handles.
+ *
+ * Objects are rooted in bulk upon insertion and all objects are unrooted upon
+ * destruction, which is cheaper than managing a `GcRootPtr` per object.
+ */
+class RootSet {
+   public:
+    /** Constructs an empty root set.
+     *
+     * \param runtime a reference to the runtime in which the objects were
+     * allocated
+     */
+    explicit RootSet(const Runtime& runtime) noexcept : m_runtime(&runtime) {}
+
+    RootSet(const RootSet&) = delete;
+    RootSet& operator=(const RootSet&) = delete;
+
+    /** Move constructs a root set.
+     *
+     * \param other an rvalue reference to a root set
+     */
+    RootSet(RootSet&& other) noexcept
+        : m_runtime(other.m_runtime), m_objs(std::exchange(other.m_objs, {})) {}
+
+    /** Move assigns a root set, unrooting the objects of this instance.
+     *
+     * \param other an rvalue reference to a root set
+     * \return a reference to this instance
+     */
+    RootSet& operator=(RootSet&& other) noexcept {
+        if (this != &other) {
+            clear();
+            m_runtime = other.m_runtime;
+            m_objs = std::exchange(other.m_objs, {});
+        }
+        return *this;
+    }
+
+    /** Destructs the root set, unrooting all of its objects. */
+    ~RootSet() noexcept { clear(); }
+
+    /** Roots all objects in `objs` and adds them to the set.
+     *
+     * Either all or none of the objects are added.
+     *
+     * \param objs garbage collection handles
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the objects were added
+     */
+    bool insert(Span<const MunGcPtr> objs, Error* out_error = nullptr) noexcept {
+        if (!m_runtime->gc_root_many(objs, out_error)) {
+            return false;
+        }
+
+        m_objs.insert(m_objs.end(), objs.begin(), objs.end());
+        return true;
+    }
+
+    /** Roots `obj` and adds it to the set.
+     *
+     * \param obj a garbage collection handle
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the object was added
+     */
+    bool insert(MunGcPtr obj, Error* out_error = nullptr) noexcept {
+        return insert(Span<const MunGcPtr>(&obj, 1), out_error);
+    }
+
+    /** Allocates `count` objects of type `type_info`, roots them and adds
+     * them to the set.
+     *
+     * Either all or none of the objects are added. The returned handles are
+     * invalidated by the next modification of the set.
+     *
+     * \param type_info the type information of the objects
+     * \param count the number of objects to allocate
+     * \param out_error a pointer that will optionally return an error
+     * \return possibly, the garbage collection handles of the new objects
+     */
+    std::optional<Span<const MunGcPtr>> alloc(MunUnsafeTypeInfo type_info, size_t count,
+                                              Error* out_error = nullptr) noexcept {
+        const auto offset = m_objs.size();
+        m_objs.resize(offset + count);
+
+        const Span<MunGcPtr> objs(m_objs.data() + offset, count);
+        if (!m_runtime->gc_alloc_many(type_info, objs, out_error) ||
+            !m_runtime->gc_root_many(objs, out_error)) {
+            m_objs.resize(offset);
+            return std::nullopt;
+        }
+        return std::make_optional<Span<const MunGcPtr>>(objs.data(), count);
+    }
+
+    /** Unroots all objects and removes them from the set.
+     *
+     * \param out_error a pointer that will optionally return the first error
+     * \return whether all objects were unrooted
+     */
+    bool clear(Error* out_error = nullptr) noexcept {
+        const bool unrooted = m_runtime->gc_unroot_many(m_objs, out_error);
+        m_objs.clear();
+        return unrooted;
+    }
+
+    /** Reserves storage for `capacity` objects. */
+    void reserve(size_t capacity) noexcept { m_objs.reserve(capacity); }
+
+    /** Retrieves the number of objects in the set. */
+    size_t size() const noexcept { return m_objs.size(); }
+
+    /** Retrieves whether the set is empty. */
+    bool empty() const noexcept { return m_objs.empty(); }
+
+    /** Retrieves the object at `idx`, without bounds checking. */
+    MunGcPtr operator[](size_t idx) const noexcept { return m_objs[idx]; }
+
+    const MunGcPtr* begin() const noexcept { return m_objs.data(); }
+    const MunGcPtr* end() const noexcept { return m_objs.data() + m_objs.size(); }
+
+   private:
+    const Runtime* m_runtime;
+    std::vector<MunGcPtr> m_objs;
+};
+}  // namespace mun
+
+#endif
@@ -1,23 +1,181 @@
 #ifndef MUN_RUNTIME_CPP_BINDINGS_H_
 #define MUN_RUNTIME_CPP_BINDINGS_H_
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <set>
+#include <shared_mutex>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include "mun/diagnostics.h"
 #include "mun/error.h"
+#include "mun/field_index.h"
 #include "mun/function.h"
+#include "mun/gc_stats.h"
 #include "mun/runtime_capi.h"
+#include "mun/safepoint.h"
+#include "mun/span.h"
 
 namespace mun {
 
 struct RuntimeOptions;
+class GcNoCollectScope;
+class MutatorScope;
+class Safepoint;
+
+/** Describes the changes made to the runtime by its most recent reload. */
+struct UpdateInfo {
+    /** The reload generation that the runtime transitioned to. */
+    uint64_t generation = 0;
+
+    /** The names of previously retrieved functions whose definitions were
+     * replaced or removed.
+     */
+    std::vector<std::string> replaced_functions;
+
+    /** The GUIDs of previously retrieved types that no longer occur in the
+     * signature of any retrieved function.
+     *
+     * Mun derives the GUID of a struct from its definition, so a struct whose
+     * fields changed is reported as well. Type information retrieved before
+     * the reload must not be dereferenced, as its memory has been unloaded.
+     */
+    std::vector<MunGuid> replaced_types;
+};
+
+namespace details {
+/** A function definition retrieved from the runtime, along with the GUIDs of
+ * the types in its signature.
+ *
+ * Type information is identified by GUID rather than by address, as a reload
+ * unloads the old types and their addresses can be reused by new ones.
+ */
+struct TrackedFunction {
+    TrackedFunction(const MunFunctionDefinition& definition) noexcept : definition(definition) {
+        const auto& signature = definition.prototype.signature;
+        type_guids.reserve(signature.num_arg_types + 1);
+        for (uint32_t idx = 0; idx < signature.num_arg_types; ++idx) {
+            type_guids.push_back(signature.arg_types[idx]->guid);
+        }
+        // A function without a return type is marked by a zeroed GUID
+        type_guids.push_back(signature.return_type ? signature.return_type->guid : MunGuid{});
+    }
+
+    MunFunctionDefinition definition;
+    std::vector<MunGuid> type_guids;
+};
+
+/** Compares GUIDs for equality. */
+inline bool guid_equal(const MunGuid& lhs, const MunGuid& rhs) noexcept {
+    return std::equal(std::begin(lhs._0), std::end(lhs._0), std::begin(rhs._0));
+}
+
+/** Orders GUIDs by their bytes. */
+inline bool guid_less(const MunGuid& lhs, const MunGuid& rhs) noexcept {
+    return std::lexicographical_compare(std::begin(lhs._0), std::end(lhs._0), std::begin(rhs._0),
+                                        std::end(rhs._0));
+}
+
+/** The garbage collection state of a runtime.
+ *
+ * It is allocated separately from the runtime, so that the background
+ * collector can refer to it while the runtime is moved.
+ */
+struct GcState {
+    explicit GcState(MunRuntimeHandle handle) noexcept : handle(handle) {}
+
+    /** Retrieves whether a scope currently prevents garbage collection. */
+    bool is_collect_blocked() const noexcept {
+        return no_collect_depth.load(std::memory_order_acquire) > 0;
+    }
+
+    /** Collects garbage unless collection is blocked, recording the
+     * collection.
+     *
+     * \return whether memory was reclaimed
+     */
+    bool collect() noexcept {
+        if (is_collect_blocked()) {
+            return false;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        bool reclaimed;
+        auto error_handle = mun_gc_collect(handle, &reclaimed);
+        assert(error_handle._0 == 0);
+
+        stats.record_collection(std::chrono::steady_clock::now() - start, reclaimed);
+        return reclaimed;
+    }
+
+    MunRuntimeHandle handle;
+    GcStatsRecorder stats;
+    std::atomic<uint32_t> no_collect_depth{0};
+};
+
+/** A task that is run every time the runtime reloads an assembly, until it
+ * reports completion.
+ */
+struct UpdateListener {
+    virtual ~UpdateListener() = default;
+
+    /** Called after the runtime reloaded an assembly.
+     *
+     * \return whether the listener is done and can be removed
+     */
+    virtual bool on_update() noexcept = 0;
+};
+}  // namespace details
 
 /** A wrapper around a `MunRuntimeHandle`.
  *
  * Frees the corresponding runtime object on destruction, if it exists.
+ *
+ * Thread safety: the following operations can be used concurrently from
+ * multiple threads, as the runtime's garbage collector synchronizes access
+ * internally and the caches of this class are guarded by locks:
+ * - invoking functions, through `invoke_fn`, `Function`, `invoke_batch`, or
+ *   `invoke_parallel`;
+ * - `find_function_definition`, `field_index`, and the layout verification of
+ *   struct mirrors;
+ * - `gc_alloc`, `gc_alloc_many`, `gc_root_ptr`, `gc_unroot_ptr`, `gc_root_many`,
+ *   `gc_unroot_many`, `ptr_type`, and `gc_stats`;
+ * - accessing the fields of distinct `StructRef`s.
+ *
+ * The following operations require exclusive access to the runtime; i.e. no
+ * other thread may use the runtime or any of its objects at the same time:
+ * - `update` and `wait_for_update`, as they unload function and type
+ *   definitions that other threads might be using;
+ * - `gc_collect` and `gc_collect_if_within`, as they can reclaim objects
+ *   that running Mun functions have not rooted;
+ * - destruction.
+ *
+ * If the runtime was created with `RuntimeOptions::background_gc`, garbage is
+ * collected on a background thread instead. Every thread that uses the runtime
+ * then has to register itself through a `MutatorScope`, and regularly allow
+ * collections through `safepoint` or a `Safepoint`; the background thread
+ * only collects garbage while all registered threads are parked. It starts
+ * when the first `MutatorScope` is entered, and collects without waiting
+ * while no thread is registered.
+ *
+ * `Function` handles and `FieldAccessor`s cache state without locking, so
+ * every thread should use its own instances.
  */
 class Runtime {
+    friend class GcNoCollectScope;
+    friend class MutatorScope;
+    friend class Safepoint;
     friend std::optional<Runtime> make_runtime(std::string_view library_path,
                                                const RuntimeOptions& options,
                                                Error* out_error) noexcept;
@@ -25,28 +183,81 @@ class Runtime {
     /** Constructs a runtime from an instantiated `MunRuntimeHandle`.
      *
      * \param handle a runtime handle
+     * \param update_poll_interval the interval at which `wait_for_update`
+     * checks for changes
+     * \param background_gc_interval optionally, the interval at which garbage
+     * is collected on a background thread
+     * \param gc_policy the conditions under which garbage is collected
+     * automatically
+     * \param gc_type_stats whether allocations are recorded per type
      */
-    Runtime(MunRuntimeHandle handle) noexcept : m_handle(handle) {}
+    Runtime(MunRuntimeHandle handle, std::chrono::microseconds update_poll_interval,
+            std::optional<std::chrono::milliseconds> background_gc_interval,
+            const details::GcPolicy& gc_policy, bool gc_type_stats) noexcept
+        : m_handle(handle),
+          m_gc(std::make_unique<details::GcState>(handle)),
+          m_update_poll_interval(update_poll_interval),
+          m_gc_collect_on_update(gc_policy.collect_on_update && !background_gc_interval) {
+        m_gc->stats.set_record_types(gc_type_stats);
+        m_gc->stats.set_policy(gc_policy);
+        if (background_gc_interval) {
+            m_background_collector = std::make_unique<details::BackgroundCollector>(
+                *background_gc_interval, &Runtime::needs_collection_in_background,
+                &Runtime::collect_in_background, m_gc.get());
+        }
+    }
 
    public:
     /** Move constructs a runtime
      *
      * \param other an rvalue reference to a runtime
      */
-    Runtime(Runtime&& other) noexcept : m_handle(other.m_handle) { other.m_handle._0 = nullptr; }
+    Runtime(Runtime&& other) noexcept
+        : m_handle(other.m_handle),
+          m_generation(other.m_generation),
+          m_functions(std::move(other.m_functions)),
+          m_last_update(std::move(other.m_last_update)),
+          m_field_indices(std::move(other.m_field_indices)),
+          m_verified_layouts(std::move(other.m_verified_layouts)),
+          m_gc(std::move(other.m_gc)),
+          m_diagnostic_sink(other.m_diagnostic_sink),
+          m_update_poll_interval(other.m_update_poll_interval),
+          m_gc_collect_on_update(other.m_gc_collect_on_update),
+          m_update_listeners(std::move(other.m_update_listeners)),
+          m_background_collector(std::move(other.m_background_collector)) {
+        other.m_handle._0 = nullptr;
+    }
 
-    /** Destructs a runtime */
-    ~Runtime() noexcept { mun_runtime_destroy(m_handle); }
+    /** Destructs a runtime
+     *
+     * The background collector is stopped and pending update listeners are
+     * destroyed first, as they can own objects of the runtime.
+     */
+    ~Runtime() noexcept {
+        m_background_collector.reset();
+        m_update_listeners.clear();
+        mun_runtime_destroy(m_handle);
+    }
 
     /** Retrieves `MunFunctionDefinition` from the runtime for the corresponding
      * `fn_name`.
      *
+     * Retrieved definitions are cached until the next reload, at which point
+     * they are compared against their replacements to populate `last_update`.
+     *
      * \param fn_name the name of the desired function
      * \param out_error a pointer that will optionally return an error
      * \return possibly, the desired `MunFunctionDefinition` struct
      */
     std::optional<MunFunctionDefinition> find_function_definition(
         std::string_view fn_name, Error* out_error = nullptr) noexcept {
+        {
+            std::shared_lock<std::shared_mutex> lock(m_functions_mutex);
+            if (const auto it = m_functions.find(fn_name); it != m_functions.end()) {
+                return std::make_optional(it->second.definition);
+            }
+        }
+
         bool has_fn;
         MunFunctionDefinition temp;
         if (auto error = Error(
@@ -57,7 +268,15 @@ class Runtime {
             return std::nullopt;
         }
 
-        return has_fn ? std::make_optional(std::move(temp)) : std::nullopt;
+        if (!has_fn) {
+            return std::nullopt;
+        }
+
+        {
+            std::unique_lock<std::shared_mutex> lock(m_functions_mutex);
+            m_functions.emplace(fn_name, temp);
+        }
+        return std::make_optional(std::move(temp));
     }
 
     /**
@@ -79,22 +298,95 @@ class Runtime {
             return std::nullopt;
         }
 
+        m_gc->stats.record_allocations(*type_info, 1);
         return std::make_optional(obj);
     }
 
+    /** Allocates an object of type `type_info` for every element of `out`,
+     * storing their garbage collection handles in `out`.
+     *
+     * The objects are not rooted. If an allocation fails, the objects that were
+     * already allocated are reclaimed by the next garbage collection.
+     *
+     * \param type_info the type information of the objects
+     * \param out the storage for the garbage collection handles
+     * \param out_error a pointer that will optionally return an error
+     * \return whether all objects were allocated
+     */
+    bool gc_alloc_many(MunUnsafeTypeInfo type_info, Span<MunGcPtr> out,
+                       Error* out_error = nullptr) const noexcept {
+        for (size_t idx = 0; idx < out.size(); ++idx) {
+            if (auto error = Error(mun_gc_alloc(m_handle, type_info, &out[idx]))) {
+                m_gc->stats.record_allocations(*type_info, idx);
+                if (out_error) {
+                    *out_error = std::move(error);
+                }
+                return false;
+            }
+        }
+        m_gc->stats.record_allocations(*type_info, out.size());
+        return true;
+    }
+
     /** Collects all memory that is no longer referenced by rooted objects.
      *
      * Returns `true` if memory was reclaimed, `false` otherwise. This behavior
      * will likely change in the future.
+     *
+     * While a `GcNoCollectScope` is active, nothing is collected.
      */
-    bool gc_collect() const noexcept {
-        bool reclaimed;
-        auto error_handle = mun_gc_collect(m_handle, &reclaimed);
-        assert(error_handle._0 == 0);
+    bool gc_collect() const noexcept { return m_gc->collect(); }
 
-        return reclaimed;
+    /** Collects garbage only if a collection is expected to fit in `budget`,
+     * e.g. the time left in a frame.
+     *
+     * This never splits a collection: it either runs a full, stop-the-world
+     * collection or none at all. The runtime's garbage collector cannot
+     * interrupt a collection, so its duration is predicted from the previous
+     * ones. The first
+     * collection is always performed, to measure it. Call this every frame
+     * with the remaining frame time, and call `gc_collect` when the returned
+     * work has been deferred for too long.
+     *
+     * While a `GcNoCollectScope` is active, nothing is collected.
+     *
+     * \param budget the time available for garbage collection
+     * \return the predicted duration of the deferred collection, or zero if
+     * garbage was collected
+     */
+    std::chrono::nanoseconds gc_collect_if_within(std::chrono::microseconds budget) const noexcept {
+        const auto expected = m_gc->stats.expected_collection_time();
+        if (is_gc_collect_blocked() || expected > budget) {
+            return std::max(expected, std::chrono::nanoseconds(1));
+        }
+
+        gc_collect();
+        return std::chrono::nanoseconds(0);
+    }
+
+    /** Collects garbage if the allocations since the last collection crossed
+     * the thresholds set in `RuntimeOptions`.
+     *
+     * If `RuntimeOptions::gc_collect_on_update` is set, this is called by
+     * `update`.
+     *
+     * \return whether garbage was collected
+     */
+    bool gc_collect_if_needed() const noexcept {
+        if (is_gc_collect_blocked() || !m_gc->stats.needs_collection()) {
+            return false;
+        }
+
+        gc_collect();
+        return true;
     }
 
+    /** Retrieves the garbage collection statistics of the runtime.
+     *
+     * \return a copy of the statistics
+     */
+    GcStats gc_stats() const noexcept { return m_gc->stats.snapshot(); }
+
     /**
      * Roots the specified `obj`, which keeps it and objects it references
      * alive.
@@ -110,6 +402,7 @@ class Runtime {
     void gc_root_ptr(MunGcPtr obj) const noexcept {
         const auto error_handle = mun_gc_root(m_handle, obj);
         assert(error_handle._0 == 0);
+        m_gc->stats.record_roots(1);
     }
 
     /**
@@ -125,6 +418,58 @@ class Runtime {
     void gc_unroot_ptr(MunGcPtr obj) const noexcept {
         const auto error_handle = mun_gc_unroot(m_handle, obj);
         assert(error_handle._0 == 0);
+        m_gc->stats.record_roots(-1);
+    }
+
+    /** Roots all objects in `objs`.
+     *
+     * Either all or none of the objects are rooted: if rooting an object fails,
+     * the previously rooted objects are unrooted again.
+     *
+     * \param objs garbage collection handles
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the objects were rooted
+     */
+    bool gc_root_many(Span<const MunGcPtr> objs, Error* out_error = nullptr) const noexcept {
+        for (size_t idx = 0; idx < objs.size(); ++idx) {
+            if (auto error = Error(mun_gc_root(m_handle, objs[idx]))) {
+                for (size_t rooted = 0; rooted < idx; ++rooted) {
+                    mun_gc_unroot(m_handle, objs[rooted]);
+                }
+                if (out_error) {
+                    *out_error = std::move(error);
+                }
+                return false;
+            }
+        }
+        m_gc->stats.record_roots(static_cast<int64_t>(objs.size()));
+        return true;
+    }
+
+    /** Unroots all objects in `objs`.
+     *
+     * Objects that fail to unroot do not prevent the remaining objects from
+     * being unrooted.
+     *
+     * \param objs garbage collection handles
+     * \param out_error a pointer that will optionally return the first error
+     * \return whether all objects were unrooted
+     */
+    bool gc_unroot_many(Span<const MunGcPtr> objs, Error* out_error = nullptr) const noexcept {
+        bool unrooted = true;
+        int64_t num_unrooted = 0;
+        for (const auto obj : objs) {
+            if (auto error = Error(mun_gc_unroot(m_handle, obj))) {
+                if (unrooted && out_error) {
+                    *out_error = std::move(error);
+                }
+                unrooted = false;
+            } else {
+                ++num_unrooted;
+            }
+        }
+        m_gc->stats.record_roots(-num_unrooted);
+        return unrooted;
     }
 
     /**
@@ -141,11 +486,206 @@ class Runtime {
     }
 
     /** Checks for updates to hot reloadable assemblies.
+     *
+     * On reload, the generation is incremented and `last_update` describes
+     * which of the previously retrieved definitions were replaced. If
+     * `RuntimeOptions::gc_collect_on_update` is set, garbage is then collected
+     * if needed; see `gc_collect_if_needed`.
      *
      * \param out_error a pointer that will optionally return an error
      * \return whether the runtime was updated
      */
     bool update(Error* out_error = nullptr) {
+        std::unique_lock<std::mutex> lock(m_update_mutex);
+        const bool updated = update_locked(out_error);
+        if (m_gc_collect_on_update) {
+            gc_collect_if_needed();
+        }
+        return updated;
+    }
+
+    /** Blocks until the runtime reloads an assembly.
+     *
+     * The runtime's C API does not signal changes, so the runtime is checked
+     * for updates every `RuntimeOptions::update_poll_interval_us`. In between,
+     * the calling thread sleeps in a safe region; see `Safepoint`. It must not
+     * hold unrooted objects while waiting.
+     *
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the runtime was updated; `false` on error
+     */
+    bool wait_for_update(Error* out_error = nullptr) {
+        return wait_for_update_until(std::nullopt, out_error);
+    }
+
+    /** Blocks until the runtime reloads an assembly, or `timeout` elapses.
+     *
+     * See `wait_for_update()`.
+     *
+     * \param timeout the maximum duration to wait
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the runtime was updated; `false` on timeout or error
+     */
+    bool wait_for_update(std::chrono::milliseconds timeout, Error* out_error = nullptr) {
+        return wait_for_update_until(std::chrono::steady_clock::now() + timeout, out_error);
+    }
+
+    /** Retrieves the changes made by the most recent reload.
+     *
+     * Caches keyed on function names or type definitions can use this to
+     * invalidate only the entries that were replaced.
+     *
+     * \return a description of the most recent reload
+     */
+    const UpdateInfo& last_update() const noexcept { return m_last_update; }
+
+    /** Retrieves the index that maps the field names of the struct
+     * `type_info` to field indices.
+     *
+     * Indices are built on first use and discarded when the runtime reloads.
+     *
+     * \param type_info the type information of a struct
+     * \return the field index of the struct
+     */
+    const details::FieldIndex& field_index(const MunTypeInfo& type_info) const noexcept {
+        {
+            std::shared_lock<std::shared_mutex> lock(m_field_indices_mutex);
+            if (const auto* index = m_field_indices.find(type_info)) {
+                return *index;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(m_field_indices_mutex);
+        return m_field_indices.get(type_info);
+    }
+
+    /** Retrieves whether the layout of the struct `type_info` was verified to
+     * match the C++ mirror identified by `mirror`.
+     *
+     * Verifications are discarded when the runtime reloads.
+     *
+     * \param type_info the type information of a struct
+     * \param mirror a unique address that identifies a C++ mirror type
+     * \return whether the layout was verified
+     */
+    bool is_layout_verified(const MunTypeInfo& type_info, const void* mirror) const noexcept {
+        std::shared_lock<std::shared_mutex> lock(m_verified_layouts_mutex);
+        return m_verified_layouts.count(std::make_pair(&type_info, mirror)) != 0;
+    }
+
+    /** Records that the layout of the struct `type_info` matches the C++
+     * mirror identified by `mirror`.
+     *
+     * \param type_info the type information of a struct
+     * \param mirror a unique address that identifies a C++ mirror type
+     */
+    void set_layout_verified(const MunTypeInfo& type_info, const void* mirror) const noexcept {
+        std::unique_lock<std::shared_mutex> lock(m_verified_layouts_mutex);
+        m_verified_layouts.emplace(&type_info, mirror);
+    }
+
+    /** Parks the calling thread while the background collector collects
+     * garbage, if it requested to do so.
+     *
+     * The calling thread must be registered through a `MutatorScope`, and
+     * must not hold any unrooted objects. Without background collection, or
+     * inside a `Safepoint`, this does nothing.
+     */
+    void safepoint() const noexcept {
+        if (m_background_collector) {
+            m_background_collector->poll();
+        }
+    }
+
+    /** Retrieves the interval at which `wait_for_update` checks for changes. */
+    std::chrono::microseconds update_poll_interval() const noexcept {
+        return m_update_poll_interval;
+    }
+
+    /** Retrieves whether garbage is collected on a background thread. */
+    bool has_background_gc() const noexcept { return m_background_collector != nullptr; }
+
+    /** Retrieves whether a `GcNoCollectScope` currently prevents garbage
+     * collection.
+     */
+    bool is_gc_collect_blocked() const noexcept {
+        return m_gc->is_collect_blocked();
+    }
+
+    /** Retrieves the reload generation of the runtime.
+     *
+     * The generation starts at zero and is incremented every time `update`
+     * reloads an assembly. Function and type definitions obtained from the
+     * runtime are only valid for the generation in which they were retrieved.
+     *
+     * \return the current reload generation
+     */
+    uint64_t generation() const noexcept { return m_generation; }
+
+    /** Installs the callbacks that receive diagnostics about failed function
+     * invocations and field accesses.
+     *
+     * The sink must be installed before the runtime is used from multiple
+     * threads, and its callbacks must be thread-safe if it is.
+     *
+     * \param sink a set of diagnostic callbacks
+     */
+    void set_diagnostic_sink(const DiagnosticSink& sink) noexcept { m_diagnostic_sink = sink; }
+
+    /** Retrieves the installed diagnostic callbacks. */
+    const DiagnosticSink& diagnostic_sink() const noexcept { return m_diagnostic_sink; }
+
+    /** Reports a failed invocation of the function `fn_name` to the diagnostic
+     * sink, if one is installed.
+     *
+     * \param fn_name the name of the invoked function
+     * \param error the reason the invocation failed
+     */
+    void report(std::string_view fn_name, const InvokeError& error) const noexcept {
+        if (m_diagnostic_sink.on_invoke_error) {
+            m_diagnostic_sink.on_invoke_error(fn_name, error, m_diagnostic_sink.user_data);
+        }
+    }
+
+    /** Reports a failed access of the field `field_name` to the diagnostic
+     * sink, if one is installed.
+     *
+     * \param field_name the name of the accessed field
+     * \param error the reason the field access failed
+     */
+    void report(std::string_view field_name, const FieldError& error) const noexcept {
+        if (m_diagnostic_sink.on_field_error) {
+            m_diagnostic_sink.on_field_error(field_name, error, m_diagnostic_sink.user_data);
+        }
+    }
+
+    /** Adds a listener that is run on the thread that calls `update`, every
+     * time the runtime reloads an assembly, until the listener completes.
+     *
+     * Listeners that have not completed are destroyed with the runtime.
+     *
+     * \param listener an update listener
+     */
+    void add_update_listener(std::unique_ptr<details::UpdateListener> listener) noexcept {
+        std::lock_guard<std::mutex> lock(m_update_listeners_mutex);
+        m_update_listeners.push_back(std::move(listener));
+    }
+
+   private:
+    static bool needs_collection_in_background(const void* gc) noexcept {
+        // Without thresholds, garbage is collected at every interval
+        const auto& state = *static_cast<const details::GcState*>(gc);
+        if (state.is_collect_blocked()) {
+            return false;
+        }
+        return !state.stats.has_policy() || state.stats.needs_collection();
+    }
+
+    static void collect_in_background(void* gc) noexcept {
+        static_cast<details::GcState*>(gc)->collect();
+    }
+
+    bool update_locked(Error* out_error) {
         bool updated;
         if (auto error = Error(mun_runtime_update(m_handle, &updated))) {
             if (out_error) {
@@ -153,11 +693,259 @@ class Runtime {
             }
             return false;
         }
+        if (updated) {
+            ++m_generation;
+            refresh_functions();
+
+            // The previous assembly has been unloaded, so a cached type pointer
+            // can dangle or even be reused by a new type.
+            {
+                std::unique_lock<std::shared_mutex> lock(m_field_indices_mutex);
+                m_field_indices.clear();
+            }
+            {
+                std::unique_lock<std::shared_mutex> lock(m_verified_layouts_mutex);
+                m_verified_layouts.clear();
+            }
+            m_gc->stats.forget_types();
+            notify_update_listeners();
+        }
         return updated;
     }
 
-   private:
+    bool wait_for_update_until(std::optional<std::chrono::steady_clock::time_point> deadline,
+                               Error* out_error) {
+        std::unique_lock<std::mutex> lock(m_update_mutex);
+        const auto generation = m_generation;
+        const auto is_updated = [this, generation]() { return m_generation != generation; };
+
+        while (!is_updated()) {
+            Error error;
+            if (update_locked(&error)) {
+                return true;
+            } else if (error) {
+                if (out_error) {
+                    *out_error = std::move(error);
+                }
+                return false;
+            }
+
+            auto wake_time = std::chrono::steady_clock::now() + m_update_poll_interval;
+            if (deadline) {
+                if (std::chrono::steady_clock::now() >= *deadline) {
+                    return false;
+                }
+                wake_time = std::min(wake_time, *deadline);
+            }
+            lock.unlock();
+            sleep_until_in_safe_region(wake_time);
+            lock.lock();
+        }
+        return true;
+    }
+
+    /** Sleeps in a safe region, so that a registered mutator does not block
+     * the background collector.
+     */
+    void sleep_until_in_safe_region(std::chrono::steady_clock::time_point time) const noexcept {
+        if (m_background_collector) {
+            m_background_collector->enter_safe_region();
+        }
+        std::this_thread::sleep_until(time);
+        if (m_background_collector) {
+            m_background_collector->leave_safe_region();
+        }
+    }
+
+    void notify_update_listeners() noexcept {
+        // Listeners can add new listeners, so they are run without the lock.
+        std::vector<std::unique_ptr<details::UpdateListener>> listeners;
+        {
+            std::lock_guard<std::mutex> lock(m_update_listeners_mutex);
+            listeners.swap(m_update_listeners);
+        }
+
+        listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+                                       [](const auto& listener) { return listener->on_update(); }),
+                        listeners.end());
+
+        std::lock_guard<std::mutex> lock(m_update_listeners_mutex);
+        m_update_listeners.insert(m_update_listeners.end(),
+                                  std::make_move_iterator(listeners.begin()),
+                                  std::make_move_iterator(listeners.end()));
+    }
+
+    /** Re-retrieves all cached function definitions after a reload, recording
+     * the ones that changed.
+     */
+    void refresh_functions() noexcept {
+        std::unique_lock<std::shared_mutex> lock(m_functions_mutex);
+
+        UpdateInfo info;
+        info.generation = m_generation;
+
+        std::vector<MunGuid> old_types;
+        std::vector<MunGuid> new_types;
+        for (auto it = m_functions.begin(); it != m_functions.end();) {
+            auto& tracked = it->second;
+            old_types.insert(old_types.end(), tracked.type_guids.begin(), tracked.type_guids.end());
+
+            bool has_fn;
+            MunFunctionDefinition temp;
+            if (Error(mun_runtime_get_function_definition(m_handle, it->first.c_str(), &has_fn,
+                                                          &temp)) ||
+                !has_fn) {
+                info.replaced_functions.push_back(it->first);
+                it = m_functions.erase(it);
+                continue;
+            }
+
+            details::TrackedFunction replacement(temp);
+            if (replacement.definition.fn_ptr != tracked.definition.fn_ptr ||
+                !std::equal(replacement.type_guids.begin(), replacement.type_guids.end(),
+                            tracked.type_guids.begin(), tracked.type_guids.end(),
+                            details::guid_equal)) {
+                info.replaced_functions.push_back(it->first);
+            }
+            new_types.insert(new_types.end(), replacement.type_guids.begin(),
+                             replacement.type_guids.end());
+            tracked = std::move(replacement);
+            ++it;
+        }
+
+        std::sort(old_types.begin(), old_types.end(), details::guid_less);
+        old_types.erase(std::unique(old_types.begin(), old_types.end(), details::guid_equal),
+                        old_types.end());
+        std::sort(new_types.begin(), new_types.end(), details::guid_less);
+        std::set_difference(old_types.begin(), old_types.end(), new_types.begin(),
+                            new_types.end(), std::back_inserter(info.replaced_types),
+                            details::guid_less);
+        info.replaced_types.erase(
+            std::remove_if(info.replaced_types.begin(), info.replaced_types.end(),
+                           [](const MunGuid& guid) { return details::guid_equal(guid, {}); }),
+            info.replaced_types.end());
+
+        m_last_update = std::move(info);
+    }
+
     MunRuntimeHandle m_handle;
+    uint64_t m_generation = 0;
+    std::map<std::string, details::TrackedFunction, std::less<>> m_functions;
+    mutable std::shared_mutex m_functions_mutex;
+    UpdateInfo m_last_update;
+    mutable details::FieldIndexCache m_field_indices;
+    mutable std::shared_mutex m_field_indices_mutex;
+    mutable std::set<std::pair<const MunTypeInfo*, const void*>> m_verified_layouts;
+    mutable std::shared_mutex m_verified_layouts_mutex;
+    std::unique_ptr<details::GcState> m_gc;
+    DiagnosticSink m_diagnostic_sink;
+    std::chrono::microseconds m_update_poll_interval;
+    bool m_gc_collect_on_update;
+    std::mutex m_update_mutex;
+    std::vector<std::unique_ptr<details::UpdateListener>> m_update_listeners;
+    std::mutex m_update_listeners_mutex;
+    std::unique_ptr<details::BackgroundCollector> m_background_collector;
+};
+
+/** A scope in which the runtime does not collect garbage.
+ *
+ * Within the scope, unrooted objects - such as those borrowed by a
+ * `StructView` - remain alive, as calls to `Runtime::gc_collect` do nothing.
+ * Scopes can be nested and can be active on multiple threads at once.
+ */
+class GcNoCollectScope {
+   public:
+    /** Starts a scope in which `runtime` does not collect garbage.
+     *
+     * \param runtime the runtime
+     */
+    explicit GcNoCollectScope(const Runtime& runtime) noexcept : m_runtime(&runtime) {
+        m_runtime->m_gc->no_collect_depth.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    GcNoCollectScope(const GcNoCollectScope&) = delete;
+    GcNoCollectScope& operator=(const GcNoCollectScope&) = delete;
+
+    /** Ends the scope. */
+    ~GcNoCollectScope() noexcept {
+        m_runtime->m_gc->no_collect_depth.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+   private:
+    const Runtime* m_runtime;
+};
+
+/** A scope in which the calling thread is registered as a mutator of a
+ * runtime with background garbage collection; i.e. a thread that invokes
+ * functions or accesses objects.
+ *
+ * The background collector waits for all registered threads to park at a
+ * safepoint. Scopes must not be nested on a single thread, but `Safepoint`
+ * regions can be; a thread is parked until it leaves its outermost region.
+ * Without background collection, a scope does nothing.
+ */
+class MutatorScope {
+   public:
+    /** Registers the calling thread as a mutator of `runtime`, after any
+     * pending collection.
+     *
+     * \param runtime the runtime
+     */
+    explicit MutatorScope(const Runtime& runtime) noexcept
+        : m_collector(runtime.m_background_collector.get()) {
+        if (m_collector) {
+            m_collector->attach();
+        }
+    }
+
+    MutatorScope(const MutatorScope&) = delete;
+    MutatorScope& operator=(const MutatorScope&) = delete;
+
+    /** Unregisters the calling thread. */
+    ~MutatorScope() noexcept {
+        if (m_collector) {
+            m_collector->detach();
+        }
+    }
+
+   private:
+    details::BackgroundCollector* m_collector;
+};
+
+/** A region in which a registered mutator thread does not access the objects
+ * of a runtime, so that the background collector can collect garbage at any
+ * time; e.g. around blocking I/O.
+ *
+ * Upon leaving the outermost region, the thread waits for a pending
+ * collection to finish. Regions can be nested, and `Runtime::safepoint` does
+ * nothing inside one. Without background collection, or on a thread that is
+ * not registered, a region does nothing.
+ */
+class Safepoint {
+   public:
+    /** Enters a safe region of `runtime`.
+     *
+     * \param runtime the runtime
+     */
+    explicit Safepoint(const Runtime& runtime) noexcept
+        : m_collector(runtime.m_background_collector.get()) {
+        if (m_collector) {
+            m_collector->enter_safe_region();
+        }
+    }
+
+    Safepoint(const Safepoint&) = delete;
+    Safepoint& operator=(const Safepoint&) = delete;
+
+    /** Leaves the safe region. */
+    ~Safepoint() noexcept {
+        if (m_collector) {
+            m_collector->leave_safe_region();
+        }
+    }
+
+   private:
+    details::BackgroundCollector* m_collector;
 };
 
 struct RuntimeOptions {
@@ -167,6 +955,73 @@ struct RuntimeOptions {
      */
     uint32_t delay_ms = 0;
 
+    /** The interval at which `Runtime::wait_for_update` checks for changes.
+     * `0` will initialize this value to default.
+     */
+    uint32_t update_poll_interval_us = 0;
+
+    /** The `update_poll_interval_us` that is used if none is specified. */
+    static constexpr uint32_t DEFAULT_UPDATE_POLL_INTERVAL_US = 1000;
+
+    /** Whether garbage is collected on a background thread. See `MutatorScope`
+     * and `Safepoint`.
+     */
+    bool background_gc = false;
+
+    /** The interval at which the background thread collects garbage. `0` will
+     * initialize this value to default.
+     */
+    uint32_t background_gc_interval_ms = 0;
+
+    /** The `background_gc_interval_ms` that is used if none is specified. */
+    static constexpr uint32_t DEFAULT_BACKGROUND_GC_INTERVAL_MS = 100;
+
+    /** The number of bytes that can be allocated through the runtime after a
+     * collection before garbage is collected automatically; by
+     * `Runtime::gc_collect_if_needed`, or by the background thread. `0`
+     * disables automatic collection.
+     *
+     * This is not a limit on the heap size, which the runtime does not report.
+     * Only allocations through `Runtime::gc_alloc` and `Runtime::gc_alloc_many`
+     * are counted, including the copies made when marshalling a
+     * `struct(value)` as a `StructRef`. Objects allocated by Mun functions
+     * themselves are not, so this does not bound a heap that is mostly
+     * allocated by scripts.
+     */
+    uint64_t gc_collect_after_alloc_bytes = 0;
+
+    /** The factor by which the heap may grow relative to the objects that
+     * survived a collection, before the next automatic collection; i.e. the
+     * next collection is triggered once the larger of
+     * `gc_collect_after_alloc_bytes` and `gc_heap_growth_factor - 1` times the
+     * surviving bytes has been allocated. This prevents back-to-back
+     * collections of a live heap. `0` will initialize this value to default.
+     *
+     * The survivors are estimated from the number of roots held through the
+     * runtime and the average size of the objects allocated through it.
+     */
+    double gc_heap_growth_factor = 0;
+
+    /** The `gc_heap_growth_factor` that is used if none is specified. */
+    static constexpr double DEFAULT_GC_HEAP_GROWTH_FACTOR = 2.0;
+
+    /** The maximum expected duration of an automatic collection. Longer
+     * collections are deferred until twice the threshold has been allocated. `0`
+     * disables the pause target.
+     */
+    uint32_t gc_max_pause_us = 0;
+
+    /** Whether `Runtime::update` collects garbage when the thresholds above
+     * are crossed. This makes every `update` a potential full collection, so
+     * it is disabled by default. Ignored with `background_gc`.
+     */
+    bool gc_collect_on_update = false;
+
+    /** Whether `Runtime::gc_stats` reports allocations per type. Recording
+     * them takes a lock on every allocation, so it is disabled by default.
+     */
+    bool gc_type_stats = false;
+
     /**
      * A list of functions to add to the runtime, these functions can be called from Mun as *extern*
      * functions.
@@ -212,7 +1067,26 @@ inline std::optional<Runtime> make_runtime(std::string_view library_path,
         return std::nullopt;
     }
 
-    return Runtime(handle);
+    const auto update_poll_interval_us = options.update_poll_interval_us != 0
+                                             ? options.update_poll_interval_us
+                                             : RuntimeOptions::DEFAULT_UPDATE_POLL_INTERVAL_US;
+    std::optional<std::chrono::milliseconds> background_gc_interval;
+    if (options.background_gc) {
+        background_gc_interval = std::chrono::milliseconds(
+            options.background_gc_interval_ms != 0
+                ? options.background_gc_interval_ms
+                : RuntimeOptions::DEFAULT_BACKGROUND_GC_INTERVAL_MS);
+    }
+
+    details::GcPolicy gc_policy;
+    gc_policy.collect_after_alloc_bytes = options.gc_collect_after_alloc_bytes;
+    gc_policy.heap_growth_factor = options.gc_heap_growth_factor != 0
+                                       ? options.gc_heap_growth_factor
+                                       : RuntimeOptions::DEFAULT_GC_HEAP_GROWTH_FACTOR;
+    gc_policy.max_pause = std::chrono::microseconds(options.gc_max_pause_us);
+    gc_policy.collect_on_update = options.gc_collect_on_update;
+    return Runtime(handle, std::chrono::microseconds(update_poll_interval_us),
+                   background_gc_interval, gc_policy, options.gc_type_stats);
 }
 }  // namespace mun
 
@@ -0,0 +1,164 @@
+#ifndef MUN_SAFEPOINT_H_
+#define MUN_SAFEPOINT_H_
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace mun {
+namespace details {
+/** Collects garbage on a dedicated thread, whenever all registered mutator
+ * threads are parked at a safepoint.
+ *
+ * A mutator is a thread that accesses the runtime's objects. Mutators park
+ * either by polling for a pending collection, or by entering a safe region in
+ * which they do not access objects.
+ *
+ * The thread is started when the first mutator attaches, so nothing is
+ * collected while the runtime is still being set up. Afterwards, garbage is
+ * collected without waiting while no mutator is attached; a thread must
+ * attach before it accesses objects.
+ *
+ * A thread attaches at most once at a time. Parking is tracked per thread:
+ * safe regions can be nested, polling inside a safe region does nothing, and
+ * safe regions of threads that are not attached are ignored.
+ */
+class BackgroundCollector {
+   public:
+    using NeedsCollectionFn = bool (*)(const void* context) noexcept;
+    using CollectFn = void (*)(void* context) noexcept;
+
+    /** Constructs a collector, without starting its thread.
+     *
+     * \param interval the interval at which the collector checks whether to
+     * collect garbage
+     * \param needs_collection a function that decides whether to collect
+     * garbage, before the mutators are asked to park
+     * \param collect a function that collects garbage
+     * \param context the context passed to `needs_collection` and `collect`,
+     * which must outlive the collector
+     */
+    BackgroundCollector(std::chrono::milliseconds interval, NeedsCollectionFn needs_collection,
+                        CollectFn collect, void* context) noexcept
+        : m_interval(interval),
+          m_needs_collection(needs_collection),
+          m_collect(collect),
+          m_context(context) {}
+
+    BackgroundCollector(const BackgroundCollector&) = delete;
+    BackgroundCollector& operator=(const BackgroundCollector&) = delete;
+
+    /** Stops and joins the collector thread, if it was started. */
+    ~BackgroundCollector() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopped = true;
+        }
+        m_cv.notify_all();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    /** Registers the calling thread as a mutator, after any pending
+     * collection. The first mutator starts the collector thread.
+     */
+    void attach() noexcept {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_thread.joinable()) {
+            m_thread = std::thread([this]() { run(); });
+        }
+        m_cv.wait(lock, [this]() { return !m_requested.load(std::memory_order_relaxed); });
+        [[maybe_unused]] const bool attached =
+            m_park_depths.emplace(std::this_thread::get_id(), 0).second;
+        assert(attached && "a thread must not attach twice");
+    }
+
+    /** Unregisters the calling thread as a mutator. */
+    void detach() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            assert(m_park_depths.count(std::this_thread::get_id()) == 1);
+            m_park_depths.erase(std::this_thread::get_id());
+        }
+        m_cv.notify_all();
+    }
+
+    /** Parks the calling mutator until a pending collection has finished. */
+    void poll() noexcept {
+        if (m_requested.load(std::memory_order_acquire)) {
+            enter_safe_region();
+            leave_safe_region();
+        }
+    }
+
+    /** Marks the calling mutator as parked, until it leaves the outermost
+     * safe region.
+     */
+    void enter_safe_region() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const auto it = m_park_depths.find(std::this_thread::get_id());
+            if (it == m_park_depths.end() || it->second++ > 0) {
+                return;
+            }
+            ++m_num_parked;
+        }
+        m_cv.notify_all();
+    }
+
+    /** Unparks the calling mutator when it leaves the outermost safe region,
+     * after any pending collection.
+     */
+    void leave_safe_region() noexcept {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const auto it = m_park_depths.find(std::this_thread::get_id());
+        if (it == m_park_depths.end() || --it->second > 0) {
+            return;
+        }
+        m_cv.wait(lock, [this]() { return !m_requested.load(std::memory_order_relaxed); });
+        --m_num_parked;
+    }
+
+   private:
+    void run() noexcept {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_cv.wait_for(lock, m_interval, [this]() { return m_stopped; })) {
+            if (!m_needs_collection(m_context)) {
+                continue;
+            }
+
+            m_requested.store(true, std::memory_order_release);
+            m_cv.wait(lock,
+                      [this]() { return m_stopped || m_num_parked == m_park_depths.size(); });
+            if (!m_stopped) {
+                // Mutators cannot attach or unpark while the lock is held.
+                m_collect(m_context);
+            }
+            m_requested.store(false, std::memory_order_release);
+            m_cv.notify_all();
+        }
+    }
+
+    std::chrono::milliseconds m_interval;
+    NeedsCollectionFn m_needs_collection;
+    CollectFn m_collect;
+    void* m_context;
+    std::atomic<bool> m_requested{false};
+    bool m_stopped = false;
+    // The safe region depth of every attached mutator
+    std::unordered_map<std::thread::id, size_t> m_park_depths;
+    size_t m_num_parked = 0;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread m_thread;
+};
+}  // namespace details
+}  // namespace mun
+
+#endif
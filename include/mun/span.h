@@ -0,0 +1,59 @@
+#ifndef MUN_SPAN_H_
+#define MUN_SPAN_H_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace mun {
+/** A non-owning view over a contiguous sequence of elements.
+ *
+ * A C++17 stand-in for `std::span` with a dynamic extent.
+ */
+template <typename T>
+class Span {
+   public:
+    /** Constructs an empty span. */
+    constexpr Span() noexcept : m_data(nullptr), m_size(0) {}
+
+    /** Constructs a span over `size` elements, starting at `data`.
+     *
+     * \param data a pointer to the first element
+     * \param size the number of elements
+     */
+    constexpr Span(T* data, size_t size) noexcept : m_data(data), m_size(size) {}
+
+    /** Constructs a span over the elements of a contiguous container, such as
+     * a `std::vector` or `std::array`.
+     *
+     * \param container a contiguous container
+     */
+    template <typename Container,
+              typename = std::enable_if_t<std::is_convertible_v<
+                  decltype(std::data(std::declval<Container&>())), T*>>>
+    constexpr Span(Container& container) noexcept
+        : m_data(std::data(container)), m_size(std::size(container)) {}
+
+    /** Retrieves a pointer to the first element. */
+    constexpr T* data() const noexcept { return m_data; }
+
+    /** Retrieves the number of elements. */
+    constexpr size_t size() const noexcept { return m_size; }
+
+    /** Retrieves whether the span is empty. */
+    constexpr bool empty() const noexcept { return m_size == 0; }
+
+    /** Retrieves the element at `idx`, without bounds checking. */
+    constexpr T& operator[](size_t idx) const noexcept { return m_data[idx]; }
+
+    constexpr T* begin() const noexcept { return m_data; }
+    constexpr T* end() const noexcept { return m_data + m_size; }
+
+   private:
+    T* m_data;
+    size_t m_size;
+};
+}  // namespace mun
+
+#endif
@@ -0,0 +1,331 @@
+#ifndef MUN_STRUCT_MIRROR_H_
+#define MUN_STRUCT_MIRROR_H_
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "mun/diagnostics.h"
+#include "mun/reflection.h"
+#include "mun/runtime.h"
+#include "mun/span.h"
+#include "mun/struct_ref.h"
+#include "mun/type_info.h"
+
+#define MUN_DETAILS_EXPAND(x) x
+
+#define MUN_DETAILS_FOR_EACH_1(m, d, x) m(d, x)
+#define MUN_DETAILS_FOR_EACH_2(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_1(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_3(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_2(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_4(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_3(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_5(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_4(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_6(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_5(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_7(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_6(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_8(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_7(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_9(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_8(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_10(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_9(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_11(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_10(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_12(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_11(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_13(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_12(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_14(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_13(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_15(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_14(m, d, __VA_ARGS__))
+#define MUN_DETAILS_FOR_EACH_16(m, d, x, ...) \
+    m(d, x) MUN_DETAILS_EXPAND(MUN_DETAILS_FOR_EACH_15(m, d, __VA_ARGS__))
+
+#define MUN_DETAILS_GET_FOR_EACH(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, \
+                                 _15, _16, name, ...)                                         \
+    name
+
+/** Calls the macro `m(d, x)` for every argument `x` of up to 16 arguments. */
+#define MUN_DETAILS_FOR_EACH(m, d, ...)                                                       \
+    MUN_DETAILS_EXPAND(MUN_DETAILS_GET_FOR_EACH(                                              \
+        __VA_ARGS__, MUN_DETAILS_FOR_EACH_16, MUN_DETAILS_FOR_EACH_15, MUN_DETAILS_FOR_EACH_14, \
+        MUN_DETAILS_FOR_EACH_13, MUN_DETAILS_FOR_EACH_12, MUN_DETAILS_FOR_EACH_11,            \
+        MUN_DETAILS_FOR_EACH_10, MUN_DETAILS_FOR_EACH_9, MUN_DETAILS_FOR_EACH_8,              \
+        MUN_DETAILS_FOR_EACH_7, MUN_DETAILS_FOR_EACH_6, MUN_DETAILS_FOR_EACH_5,               \
+        MUN_DETAILS_FOR_EACH_4, MUN_DETAILS_FOR_EACH_3, MUN_DETAILS_FOR_EACH_2,               \
+        MUN_DETAILS_FOR_EACH_1, )(m, d, __VA_ARGS__))
+
+#define MUN_DETAILS_MIRROR_MEMBER_IMPL(ty, field) ty field;
+#define MUN_DETAILS_MIRROR_MEMBER(mirror, field) \
+    MUN_DETAILS_EXPAND(MUN_DETAILS_MIRROR_MEMBER_IMPL field)
+
+#define MUN_DETAILS_MIRROR_FIELD_IMPL(mirror, ty, field)                               \
+    ::mun::details::MirrorField{#field, ::mun::TypeInfo<ty>::Type.guid,               \
+                                ::mun::TypeInfo<ty>::Type.name, offsetof(mirror, field)},
+#define MUN_DETAILS_MIRROR_FIELD_UNPACKED(...) \
+    MUN_DETAILS_EXPAND(MUN_DETAILS_MIRROR_FIELD_IMPL(__VA_ARGS__))
+#define MUN_DETAILS_UNPAREN(...) __VA_ARGS__
+#define MUN_DETAILS_MIRROR_FIELD(mirror, field) \
+    MUN_DETAILS_MIRROR_FIELD_UNPACKED(mirror, MUN_DETAILS_UNPAREN field)
+
+namespace mun {
+namespace details {
+/** Describes a field of a C++ struct that mirrors a Mun struct. */
+struct MirrorField {
+    const char* name;
+    MunGuid type_guid;
+    const char* type_name;
+    size_t offset;
+};
+
+/** A unique address per mirror type, which identifies it in the runtime's
+ * cache of verified layouts.
+ */
+template <typename T>
+struct MirrorKey {
+    static constexpr char value = 0;
+};
+}  // namespace details
+
+/** Declares a C++ struct `name` that mirrors the memory layout of a Mun struct
+ * with the same fields, e.g.:
+ *
+ *     MUN_STRUCT(Vec3, (float, x), (float, y), (float, z));
+ *
+ * Fields are specified as `(type, name)` pairs of primitive types, in the
+ * order in which the Mun struct declares them. Up to 16 fields are supported.
+ * As the fields of Mun tuple structs are named after their indices, their
+ * mirrors are matched by position instead. The layout is verified against the
+ * runtime's type information by `make_gc_ptr`, `load_into` and `store_from`.
+ */
+#define MUN_STRUCT(name, ...)                                                          \
+    struct name {                                                                      \
+        MUN_DETAILS_FOR_EACH(MUN_DETAILS_MIRROR_MEMBER, name, __VA_ARGS__)             \
+                                                                                       \
+        static constexpr auto mun_fields() noexcept {                                  \
+            return std::array{MUN_DETAILS_FOR_EACH(MUN_DETAILS_MIRROR_FIELD, name,     \
+                                                   __VA_ARGS__)};                      \
+        }                                                                              \
+    };                                                                                 \
+    static_assert(std::is_standard_layout_v<name> && std::is_trivially_copyable_v<name>, \
+                  "a Mun struct mirror must be a standard-layout, trivially copyable type")
+
+namespace details {
+/** Verifies that the struct `type_info` has the memory layout of the C++
+ * mirror `T`, consulting and updating the runtime's cache of verified
+ * layouts.
+ *
+ * \param runtime the runtime in which the struct was allocated
+ * \param type_info the type information of a struct
+ * \param out_error a pointer that will optionally return an error
+ * \return whether the layouts match
+ */
+template <typename T>
+bool verify_layout(const Runtime& runtime, const MunTypeInfo& type_info,
+                   FieldError* out_error = nullptr) noexcept {
+    const void* mirror = &MirrorKey<T>::value;
+    if (runtime.is_layout_verified(type_info, mirror)) {
+        return true;
+    }
+
+    const auto report_mismatch = [&](std::string_view field_name) {
+        FieldError error{FieldErrorKind::LayoutMismatch};
+        error.struct_type = type_info.name;
+        report_field_error(runtime, field_name, error, out_error);
+        return false;
+    };
+
+    constexpr auto fields = T::mun_fields();
+    const auto& struct_info = type_info.data.struct_;
+    if (type_info.data.tag != MunTypeInfoData_Tag::Struct ||
+        struct_info.num_fields != fields.size() ||
+        type_info_size_in_bytes(type_info) != sizeof(T)) {
+        return report_mismatch(std::string_view());
+    }
+
+    for (size_t idx = 0; idx < fields.size(); ++idx) {
+        const auto& field = fields[idx];
+        const char* field_name = struct_info.field_names[idx];
+        if (std::strcmp(field_name, field.name) != 0 && field_name != std::to_string(idx)) {
+            return report_mismatch(field_name);
+        }
+
+        const auto* field_type = struct_info.field_types[idx];
+        if (field_type->guid != field.type_guid) {
+            FieldError error{FieldErrorKind::TypeMismatch};
+            error.struct_type = type_info.name;
+            error.expected_type = field_type->name;
+            error.found_type = field.type_name;
+            report_field_error(runtime, field_name, error, out_error);
+            return false;
+        }
+
+        if (struct_info.field_offsets[idx] != field.offset) {
+            return report_mismatch(field_name);
+        }
+    }
+
+    runtime.set_layout_verified(type_info, mirror);
+    return true;
+}
+}  // namespace details
+
+/** A rooted pointer to a Mun struct that is accessed through its C++ mirror
+ * `T`, declared with `MUN_STRUCT`.
+ *
+ * As the layout was verified upon construction, fields are accessed as plain
+ * members, without name lookups or type checks. Updating the runtime can
+ * change the layout of the struct, so a `GcPtr` has to be re-created through
+ * `make_gc_ptr` afterwards.
+ */
+template <typename T>
+class GcPtr {
+    template <typename U>
+    friend std::optional<GcPtr<U>> make_gc_ptr(StructRef s, FieldError* out_error) noexcept;
+
+    explicit GcPtr(StructRef&& s) noexcept : m_struct(std::move(s)) {}
+
+   public:
+    /** Retrieves a pointer to the struct's memory. */
+    T* get() const noexcept {
+        assert(m_struct.runtime().generation() == m_generation);
+        return reinterpret_cast<T*>(*m_struct.raw());
+    }
+
+    T& operator*() const noexcept { return *get(); }
+    T* operator->() const noexcept { return get(); }
+
+    /** Retrieves the type-agnostic struct. */
+    const StructRef& ref() const noexcept { return m_struct; }
+
+   private:
+    StructRef m_struct;
+    uint64_t m_generation = m_struct.runtime().generation();
+};
+
+/** Creates a typed pointer to the struct `s`, after verifying that its memory
+ * layout matches the C++ mirror `T`.
+ *
+ * Each Mun struct type is only verified once per reload of the runtime.
+ *
+ * \param s a struct
+ * \param out_error a pointer that will optionally return an error
+ * \return possibly, a typed pointer to the struct
+ */
+template <typename T>
+std::optional<GcPtr<T>> make_gc_ptr(StructRef s, FieldError* out_error = nullptr) noexcept {
+    if (!details::verify_layout<T>(s.runtime(), *s.info(), out_error)) {
+        return std::nullopt;
+    }
+    return GcPtr<T>(std::move(s));
+}
+
+template <typename T>
+bool StructView::load_into(T& out, FieldError* out_error) const noexcept {
+    if (!details::verify_layout<T>(*m_runtime, *info(), out_error)) {
+        return false;
+    }
+    std::memcpy(&out, *m_raw, sizeof(T));
+    return true;
+}
+
+template <typename T>
+bool StructView::store_from(const T& value, FieldError* out_error) noexcept {
+    if (!details::verify_layout<T>(*m_runtime, *info(), out_error)) {
+        return false;
+    }
+    std::memcpy(*m_raw, &value, sizeof(T));
+    return true;
+}
+
+template <typename T>
+bool StructRef::load_into(T& out, FieldError* out_error) const noexcept {
+    return StructView(*this).load_into(out, out_error);
+}
+
+template <typename T>
+bool StructRef::store_from(const T& value, FieldError* out_error) noexcept {
+    return StructView(*this).store_from(value, out_error);
+}
+
+namespace details {
+/** Verifies that all `structs` have the memory layout of the C++ mirror `T`.
+ *
+ * Structs usually share a type, so the layout is only verified again when the
+ * type differs from that of the previous struct.
+ */
+template <typename T>
+bool verify_layouts(Span<const StructRef> structs, FieldError* out_error) noexcept {
+    const MunTypeInfo* verified = nullptr;
+    for (const auto& s : structs) {
+        const MunTypeInfo* type_info = s.info();
+        if (type_info != verified) {
+            if (!verify_layout<T>(s.runtime(), *type_info, out_error)) {
+                return false;
+            }
+            verified = type_info;
+        }
+    }
+    return true;
+}
+}  // namespace details
+
+/** Copies the memory of every struct in `structs` into the corresponding
+ * element of `out`.
+ *
+ * The layouts of all structs are verified before any memory is copied.
+ *
+ * \param structs the structs to load
+ * \param out the C++ mirrors to load the structs into, one per struct
+ * \param out_error a pointer that will optionally return an error
+ * \return whether the structs were loaded
+ */
+template <typename T>
+bool load_into(Span<const StructRef> structs, Span<T> out,
+               FieldError* out_error = nullptr) noexcept {
+    if (structs.size() != out.size() || !details::verify_layouts<T>(structs, out_error)) {
+        return false;
+    }
+    for (size_t idx = 0; idx < structs.size(); ++idx) {
+        std::memcpy(&out[idx], *structs[idx].raw(), sizeof(T));
+    }
+    return true;
+}
+
+/** Copies every element of `values` into the memory of the corresponding
+ * struct in `structs`.
+ *
+ * The layouts of all structs are verified before any memory is copied, so
+ * either all or none of the structs are modified.
+ *
+ * \param structs the structs to store into
+ * \param values the C++ mirrors to store, one per struct
+ * \param out_error a pointer that will optionally return an error
+ * \return whether the structs were stored
+ */
+template <typename T>
+bool store_from(Span<const StructRef> structs, Span<const T> values,
+                FieldError* out_error = nullptr) noexcept {
+    if (structs.size() != values.size() || !details::verify_layouts<T>(structs, out_error)) {
+        return false;
+    }
+    for (size_t idx = 0; idx < structs.size(); ++idx) {
+        std::memcpy(*structs[idx].raw(), &values[idx], sizeof(T));
+    }
+    return true;
+}
+}  // namespace mun
+
+#endif
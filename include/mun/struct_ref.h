@@ -1,41 +1,46 @@
 #ifndef MUN_STRUCT_REF_H_
 #define MUN_STRUCT_REF_H_
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
-#include <iostream>
 #include <optional>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <variant>
 
+#include "mun/diagnostics.h"
 #include "mun/gc.h"
 #include "mun/marshal.h"
 #include "mun/runtime.h"
 
 namespace mun {
 namespace details {
-inline std::optional<size_t> find_index(std::string_view type_name,
-                                        const MunStructInfo& struct_info,
-                                        std::string_view field_name) noexcept {
-    const auto begin = struct_info.field_names;
-    const auto end = struct_info.field_names + struct_info.num_fields;
-
-    const auto it = std::find(begin, end, field_name);
-    if (it == end) {
-        std::cerr << "StructRef `" << type_name << "` does not contain field `" << field_name
-                  << "`." << std::endl;
-        return std::nullopt;
+/** Reports a failed field access to the runtime's diagnostic sink and, if set,
+ * through `out_error`.
+ */
+inline void report_field_error(const Runtime& runtime, std::string_view field_name,
+                               const FieldError& error, FieldError* out_error) noexcept {
+    runtime.report(field_name, error);
+    if (out_error) {
+        *out_error = error;
     }
-
-    return std::make_optional(std::distance(begin, it));
 }
 
-inline std::string format_struct_field(std::string_view struct_name,
-                                       std::string_view field_name) noexcept {
-    std::string formatted;
-    formatted.reserve(struct_name.size() + 2 + field_name.size());
+inline std::optional<size_t> find_index(const Runtime& runtime, const MunTypeInfo& type_info,
+                                        std::string_view field_name,
+                                        FieldError* out_error = nullptr) noexcept {
+    const auto idx = runtime.field_index(type_info).find(field_name);
+    if (!idx) {
+        FieldError error{FieldErrorKind::FieldNotFound};
+        error.struct_type = type_info.name;
+        report_field_error(runtime, field_name, error, out_error);
+    }
 
-    return formatted.append(struct_name).append("::").append(field_name);
+    return idx;
 }
 }  // namespace details
 
@@ -43,10 +48,126 @@ inline size_t type_info_size_in_bytes(const MunTypeInfo& type_info) noexcept {
     return static_cast<size_t>((type_info.size_in_bits + 7) / 8);
 }
 
+namespace details {
+/** Copies the struct at `ptr` into a garbage collected object.
+ *
+ * \param ptr a pointer to a value struct, or to a handle of a gc struct
+ * \param runtime the runtime in which the struct was allocated
+ * \param type_info the type information of the struct
+ * \return a handle to the copied value struct, or the handle of the gc struct
+ */
+inline MunGcPtr copy_struct_from(const MunGcPtr* ptr, const Runtime& runtime,
+                                 const MunTypeInfo& type_info) noexcept {
+    if (type_info.data.struct_.memory_kind == MunStructMemoryKind::Value) {
+        // Create a new managed object
+        const auto gc_handle = *runtime.gc_alloc(const_cast<MunUnsafeTypeInfo>(&type_info));
+
+        // Copy the old object into the new object
+        std::memcpy(*gc_handle, ptr, type_info_size_in_bytes(type_info));
+        return gc_handle;
+    } else {
+        // For a gc struct, `ptr` points to a `MunGcPtr`.
+        return *ptr;
+    }
+}
+
+/** Stores the struct `value` at `ptr`.
+ *
+ * \param value a handle to the struct
+ * \param ptr a pointer to a value struct, or to a handle of a gc struct
+ * \param type_info the type information of the struct
+ */
+inline void move_struct_to(MunGcPtr value, MunGcPtr* ptr, const MunTypeInfo& type_info) noexcept {
+    if (type_info.data.struct_.memory_kind == MunStructMemoryKind::Value) {
+        // Copy the `struct(value)` into the old object
+        std::memcpy(ptr, *value, type_info_size_in_bytes(type_info));
+    } else {
+        *ptr = value;
+    }
+}
+
+/** Stores the struct `value` at `ptr`, returning the struct that was stored
+ * there before.
+ *
+ * \param value a handle to the struct
+ * \param ptr a pointer to a value struct, or to a handle of a gc struct
+ * \param runtime the runtime in which the struct was allocated
+ * \param type_info the type information of the struct
+ * \return a handle to the replaced struct
+ */
+inline MunGcPtr swap_struct_at(MunGcPtr value, MunGcPtr* ptr, const Runtime& runtime,
+                               const MunTypeInfo& type_info) noexcept {
+    if (type_info.data.struct_.memory_kind == MunStructMemoryKind::Value) {
+        // Create a new managed object
+        const auto gc_handle = *runtime.gc_alloc(const_cast<MunUnsafeTypeInfo>(&type_info));
+
+        const auto size = type_info_size_in_bytes(type_info);
+        // Copy the old object into the new object
+        std::memcpy(*gc_handle, ptr, size);
+        // Copy the `struct(value)` into the old object
+        std::memcpy(ptr, *value, size);
+        return gc_handle;
+    } else {
+        // For a gc struct, `ptr` points to a `MunGcPtr`.
+        return std::exchange(*ptr, value);
+    }
+}
+
+/** The type information of a garbage collected object, cached for the reload
+ * generation in which it was retrieved.
+ */
+class CachedTypeInfo {
+   public:
+    /** Constructs a cache from the type information `type_info`, which was
+     * retrieved in the reload generation `generation`.
+     */
+    CachedTypeInfo(MunUnsafeTypeInfo type_info, uint64_t generation) noexcept
+        : m_type_info(type_info), m_generation(generation) {}
+
+    CachedTypeInfo(const CachedTypeInfo& other) noexcept
+        : m_type_info(other.m_type_info.load(std::memory_order_relaxed)),
+          m_generation(other.m_generation.load(std::memory_order_acquire)) {}
+
+    CachedTypeInfo& operator=(const CachedTypeInfo& other) noexcept {
+        m_type_info.store(other.m_type_info.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+        m_generation.store(other.m_generation.load(std::memory_order_acquire),
+                           std::memory_order_release);
+        return *this;
+    }
+
+    /** Retrieves the type information of `obj`, which is only retrieved from
+     * the runtime again if it was updated.
+     *
+     * \param runtime the runtime in which `obj` was allocated
+     * \param obj a garbage collection handle
+     * \return the handle's type information
+     */
+    MunUnsafeTypeInfo get(const Runtime& runtime, MunGcPtr obj) const noexcept {
+        const auto generation = runtime.generation();
+        if (m_generation.load(std::memory_order_acquire) != generation) {
+            m_type_info.store(runtime.ptr_type(obj), std::memory_order_relaxed);
+            m_generation.store(generation, std::memory_order_release);
+        }
+        return m_type_info.load(std::memory_order_relaxed);
+    }
+
+   private:
+    // Concurrent readers can refresh the cache at the same time, but they
+    // always store the same values.
+    mutable std::atomic<MunUnsafeTypeInfo> m_type_info;
+    mutable std::atomic<uint64_t> m_generation;
+};
+}  // namespace details
+
+template <typename T>
+class FieldAccessor;
+
 /** Type-agnostic wrapper for interoperability with a Mun struct.
  *
  * Roots and unroots the underlying object upon construction and destruction,
- * respectively.
+ * respectively. Every copy adds a runtime root, unless the struct was shared
+ * through `share`. See `StructView` for a non-rooting alternative.
  */
 class StructRef {
    public:
@@ -57,8 +178,33 @@ class StructRef {
      * \param raw a raw garbage collection pointer to the object instance
      */
     StructRef(const Runtime& runtime, MunGcPtr raw) noexcept
-        : m_runtime(&runtime), m_handle(GcRootPtr(runtime, raw)) {
-        assert(runtime.ptr_type(raw)->data.tag == MunTypeInfoData_Tag::Struct);
+        : StructRef(runtime, raw, *runtime.ptr_type(raw)) {}
+
+    /** Constructs a `StructRef` that wraps a raw Mun struct of a known type.
+     *
+     * \param runtime a reference to the runtime in which the object instance
+     * was allocated
+     * \param raw a raw garbage collection pointer to the object instance
+     * \param type_info the type information of the object instance
+     */
+    StructRef(const Runtime& runtime, MunGcPtr raw, const MunTypeInfo& type_info) noexcept
+        : m_runtime(&runtime),
+          m_handle(std::in_place_type<GcRootPtr>, runtime, raw),
+          m_type_info(const_cast<MunUnsafeTypeInfo>(&type_info), runtime.generation()) {
+        assert(type_info.data.tag == MunTypeInfoData_Tag::Struct);
+    }
+
+    /** Constructs a `StructRef` that wraps a Mun struct with a shared root.
+     *
+     * \param runtime a reference to the runtime in which the object instance
+     * was allocated
+     * \param root a shared root of the object instance
+     */
+    StructRef(const Runtime& runtime, SharedGcRoot root) noexcept
+        : m_runtime(&runtime),
+          m_handle(std::move(root)),
+          m_type_info(runtime.ptr_type(raw()), runtime.generation()) {
+        assert(info()->data.tag == MunTypeInfoData_Tag::Struct);
     }
 
     StructRef(const StructRef&) noexcept = default;
@@ -70,48 +216,120 @@ class StructRef {
      *
      * \return a raw garbage collection handle
      */
-    MunGcPtr raw() const noexcept { return m_handle.handle(); }
+    MunGcPtr raw() const noexcept {
+        return std::visit([](const auto& root) { return root.handle(); }, m_handle);
+    }
+
+    /** Converts the struct's root into a reference-counted `SharedGcRoot`, if
+     * it is not shared already, and returns a copy that shares it.
+     *
+     * Afterwards, copying the struct only increments a reference count instead
+     * of adding a runtime root, which is cheaper when the struct is passed
+     * through containers and callbacks. If the shared root cannot be
+     * allocated, the struct keeps its own root and the copy adds another.
+     *
+     * \return a copy of the struct that shares its root
+     */
+    StructRef share() noexcept {
+        if (auto* root = std::get_if<GcRootPtr>(&m_handle)) {
+            SharedGcRoot shared(*m_runtime, std::move(*root));
+            if (shared.handle()) {
+                m_handle = std::move(shared);
+            }
+        }
+        return *this;
+    }
+
+    /** Retrieves whether the struct's root is shared with its copies. */
+    bool is_shared() const noexcept { return std::holds_alternative<SharedGcRoot>(m_handle); }
 
     /** Retrieves the type information of the struct.
      *
-     * Updating the runtime can invalidate the returned pointer, leading to
-     * undefined behavior when it is accessed.
+     * The type information is cached, and only retrieved from the runtime
+     * again after it was updated. Updating the runtime can invalidate the
+     * returned pointer, leading to undefined behavior when it is accessed.
      *
      * \return a pointer to the struct's type information
      */
-    const MunUnsafeTypeInfo info() const noexcept { return m_runtime->ptr_type(raw()); }
+    const MunUnsafeTypeInfo info() const noexcept { return m_type_info.get(*m_runtime, raw()); }
+
+    /** Retrieves the runtime in which the struct was allocated. */
+    const Runtime& runtime() const noexcept { return *m_runtime; }
+
+    /** Creates an accessor for the field corresponding to `field_name`, which
+     * can be reused to access the field in structs of the same type without
+     * looking it up again.
+     *
+     * \param field_name the name of the desired field
+     * \return an accessor for the desired field
+     */
+    template <typename T>
+    FieldAccessor<T> field(std::string_view field_name) const noexcept;
 
     /** Tries to retrieve the copied value of the field corresponding to
      * `field_name`.
      *
      * \param field_name the name of the desired field
+     * \param out_error a pointer that will optionally return an error
      * \return possibly, the value of the desired field
      */
     template <typename T>
-    std::optional<T> get(std::string_view field_name) const noexcept;
+    std::optional<T> get(std::string_view field_name,
+                         FieldError* out_error = nullptr) const noexcept;
 
     /** Tries to replace the value of the field corresponding to
      * `field_name`, returning its original value.
      *
      * \param field_name the name of the desired field
+     * \param value the new value of the field
+     * \param out_error a pointer that will optionally return an error
      * \return possibly, the value of the replaced field
      */
     template <typename T>
-    std::optional<T> replace(std::string_view field_name, T value) noexcept;
+    std::optional<T> replace(std::string_view field_name, T value,
+                             FieldError* out_error = nullptr) noexcept;
 
     /** Tries to set the value of the field corresponding to
      * `field_name` to the provided `value`.
      *
      * \param field_name the name of the desired field
      * \param value the new value of the field
+     * \param out_error a pointer that will optionally return an error
      * \return whether the field was set successfully
      */
     template <typename T>
-    bool set(std::string_view field_name, T value) noexcept;
+    bool set(std::string_view field_name, T value, FieldError* out_error = nullptr) noexcept;
+
+    /** Copies the whole struct into its C++ mirror `T`, declared with
+     * `MUN_STRUCT` (see struct_mirror.h).
+     *
+     * The layout is only verified once per struct type, after which loading is
+     * a single copy of the struct's memory.
+     *
+     * \param out the C++ mirror to load the struct into
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the struct was loaded
+     */
+    template <typename T>
+    bool load_into(T& out, FieldError* out_error = nullptr) const noexcept;
+
+    /** Copies the C++ mirror `value`, declared with `MUN_STRUCT` (see
+     * struct_mirror.h), into the whole struct.
+     *
+     * The layout is only verified once per struct type, after which storing is
+     * a single copy of the struct's memory.
+     *
+     * \param value the C++ mirror to store
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the struct was stored
+     */
+    template <typename T>
+    bool store_from(const T& value, FieldError* out_error = nullptr) noexcept;
 
    private:
     const Runtime* m_runtime;
-    GcRootPtr m_handle;
+    std::variant<GcRootPtr, SharedGcRoot> m_handle;
+    details::CachedTypeInfo m_type_info;
 };
 
 template <>
@@ -122,66 +340,194 @@ struct Marshal<StructRef> {
         return StructRef(runtime, ptr);
     }
 
-    static type to(StructRef value) noexcept { return value.raw(); }
+    static type to(const StructRef& value) noexcept { return value.raw(); }
 
     static StructRef copy_from(const type* ptr, const Runtime& runtime,
                                std::optional<const MunTypeInfo*> type_info) noexcept {
         // Safety: `type_info_as_struct` is guaranteed to return a value for
         // `StructRef`s.
-        const auto& struct_info = type_info.value()->data.struct_;
-
-        MunGcPtr gc_handle;
-        if (struct_info.memory_kind == MunStructMemoryKind::Value) {
-            // Create a new managed object
-            gc_handle = *runtime.gc_alloc(const_cast<MunUnsafeTypeInfo>(type_info.value()));
-
-            // Copy the old object into the new object
-            const auto size = type_info_size_in_bytes(*type_info.value());
-            std::memcpy(*gc_handle, ptr, size);
-        } else {
-            // For a gc struct, `ptr` points to a `MunGcPtr`.
-            gc_handle = *ptr;
-        }
-
-        return StructRef(runtime, gc_handle);
+        return StructRef(runtime, details::copy_struct_from(ptr, runtime, *type_info.value()),
+                         *type_info.value());
     }
 
     static void move_to(type value, type* ptr,
                         std::optional<const MunTypeInfo*> type_info) noexcept {
         // Safety: `type_info_as_struct` is guaranteed to return a value for
         // `StructRef`s.
-        const auto& struct_info = type_info.value()->data.struct_;
-        if (struct_info.memory_kind == MunStructMemoryKind::Value) {
-            const auto size = type_info_size_in_bytes(*type_info.value());
-            // Copy the `struct(value)` into the old object
-            std::memcpy(ptr, *value, size);
-        } else {
-            *ptr = std::move(value);
-        }
+        details::move_struct_to(value, ptr, *type_info.value());
     }
 
     static StructRef swap_at(type value, type* ptr, const Runtime& runtime,
                              std::optional<const MunTypeInfo*> type_info) noexcept {
         // Safety: `type_info_as_struct` is guaranteed to return a value for
         // `StructRef`s.
-        const auto& struct_info = type_info.value()->data.struct_;
-
-        MunGcPtr gc_handle;
-        if (struct_info.memory_kind == MunStructMemoryKind::Value) {
-            // Create a new managed object
-            gc_handle = *runtime.gc_alloc(const_cast<MunUnsafeTypeInfo>(type_info.value()));
-
-            const auto size = type_info_size_in_bytes(*type_info.value());
-            // Copy the old object into the new object
-            std::memcpy(*gc_handle, ptr, size);
-            // Copy the `struct(value)` into the old object
-            std::memcpy(ptr, *value, size);
-        } else {
-            // For a gc struct, `ptr` points to a `MunGcPtr`.
-            gc_handle = *ptr;
-        }
+        return StructRef(runtime, details::swap_struct_at(value, ptr, runtime, *type_info.value()),
+                         *type_info.value());
+    }
+};
+
+/** Type-agnostic, non-owning view of a Mun struct.
+ *
+ * Unlike a `StructRef`, a view does not root the underlying object, so
+ * creating and copying it does not call into the runtime. A view is only
+ * valid while the object is kept alive by other means - e.g. a `StructRef` or
+ * a reference from another rooted object - and while the runtime neither
+ * collects garbage nor updates. Use a `GcNoCollectScope`, or only collect
+ * garbage between frames, to access unrooted objects through views.
+ *
+ * As the runtime cannot update while a view is in use, the view retrieves the
+ * struct's type information only once.
+ *
+ * Only `struct(gc)`s can be retrieved as views. A `struct(value)` is copied
+ * when it is retrieved, and an unrooted copy could be collected while the
+ * view still refers to it; retrieve it as a `StructRef` or `ValueStruct`
+ * instead.
+ */
+class StructView {
+   public:
+    /** Constructs a `StructView` that borrows a raw Mun struct.
+     *
+     * \param runtime a reference to the runtime in which the object instance
+     * was allocated
+     * \param raw a raw garbage collection pointer to the object instance
+     */
+    StructView(const Runtime& runtime, MunGcPtr raw) noexcept
+        : StructView(runtime, raw, *runtime.ptr_type(raw)) {}
+
+    /** Constructs a `StructView` that borrows a raw Mun struct of a known type.
+     *
+     * \param runtime a reference to the runtime in which the object instance
+     * was allocated
+     * \param raw a raw garbage collection pointer to the object instance
+     * \param type_info the type information of the object instance
+     */
+    StructView(const Runtime& runtime, MunGcPtr raw, const MunTypeInfo& type_info) noexcept
+        : m_runtime(&runtime), m_raw(raw), m_type_info(const_cast<MunUnsafeTypeInfo>(&type_info)) {
+        assert(type_info.data.tag == MunTypeInfoData_Tag::Struct);
+    }
+
+    /** Constructs a `StructView` that borrows the struct of a `StructRef`.
+     *
+     * \param s a struct
+     */
+    StructView(const StructRef& s) noexcept
+        : m_runtime(&s.runtime()), m_raw(s.raw()), m_type_info(s.info()) {}
+
+    /** Retrieves the raw garbage collection handle of the struct.
+     *
+     * \return a raw garbage collection handle
+     */
+    MunGcPtr raw() const noexcept { return m_raw; }
+
+    /** Retrieves the type information of the struct.
+     *
+     * Updating the runtime can invalidate the returned pointer, leading to
+     * undefined behavior when it is accessed.
+     *
+     * \return a pointer to the struct's type information
+     */
+    MunUnsafeTypeInfo info() const noexcept { return m_type_info; }
+
+    /** Retrieves the runtime in which the struct was allocated. */
+    const Runtime& runtime() const noexcept { return *m_runtime; }
+
+    /** Roots the struct, creating a `StructRef` that keeps it alive. */
+    StructRef to_ref() const noexcept { return StructRef(*m_runtime, m_raw, *m_type_info); }
+
+    /** Tries to retrieve the copied value of the field corresponding to
+     * `field_name`.
+     *
+     * \param field_name the name of the desired field
+     * \param out_error a pointer that will optionally return an error
+     * \return possibly, the value of the desired field
+     */
+    template <typename T>
+    std::optional<T> get(std::string_view field_name,
+                         FieldError* out_error = nullptr) const noexcept;
+
+    /** Tries to replace the value of the field corresponding to
+     * `field_name`, returning its original value.
+     *
+     * \param field_name the name of the desired field
+     * \param value the new value of the field
+     * \param out_error a pointer that will optionally return an error
+     * \return possibly, the value of the replaced field
+     */
+    template <typename T>
+    std::optional<T> replace(std::string_view field_name, T value,
+                             FieldError* out_error = nullptr) noexcept;
+
+    /** Tries to set the value of the field corresponding to
+     * `field_name` to the provided `value`.
+     *
+     * \param field_name the name of the desired field
+     * \param value the new value of the field
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the field was set successfully
+     */
+    template <typename T>
+    bool set(std::string_view field_name, T value, FieldError* out_error = nullptr) noexcept;
+
+    /** Copies the whole struct into its C++ mirror `T`, declared with
+     * `MUN_STRUCT` (see struct_mirror.h).
+     *
+     * The layout is only verified once per struct type, after which loading is
+     * a single copy of the struct's memory.
+     *
+     * \param out the C++ mirror to load the struct into
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the struct was loaded
+     */
+    template <typename T>
+    bool load_into(T& out, FieldError* out_error = nullptr) const noexcept;
+
+    /** Copies the C++ mirror `value`, declared with `MUN_STRUCT` (see
+     * struct_mirror.h), into the whole struct.
+     *
+     * The layout is only verified once per struct type, after which storing is
+     * a single copy of the struct's memory.
+     *
+     * \param value the C++ mirror to store
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the struct was stored
+     */
+    template <typename T>
+    bool store_from(const T& value, FieldError* out_error = nullptr) noexcept;
+
+   private:
+    const Runtime* m_runtime;
+    MunGcPtr m_raw;
+    MunUnsafeTypeInfo m_type_info;
+};
+
+template <>
+struct Marshal<StructView> {
+    using type = MunGcPtr;
+
+    static StructView from(type ptr, const Runtime& runtime) noexcept {
+        return StructView(runtime, ptr);
+    }
 
-        return StructRef(runtime, gc_handle);
+    static type to(const StructView& value) noexcept { return value.raw(); }
+
+    static StructView copy_from(const type* ptr, const Runtime& runtime,
+                                std::optional<const MunTypeInfo*> type_info) noexcept {
+        // Safety: `type_info_as_struct` is guaranteed to return a value for
+        // `StructView`s, and `equals_return_type` only accepts `struct(gc)`s,
+        // so `ptr` points to a handle.
+        return StructView(runtime, *ptr, *type_info.value());
+    }
+
+    static void move_to(type value, type* ptr, std::optional<const MunTypeInfo*>) noexcept {
+        // Only `struct(gc)`s are accepted, so `ptr` points to a handle.
+        *ptr = value;
+    }
+
+    static StructView swap_at(type value, type* ptr, const Runtime& runtime,
+                              std::optional<const MunTypeInfo*> type_info) noexcept {
+        // Safety: `type_info_as_struct` is guaranteed to return a value for
+        // `StructView`s, and `equals_return_type` only accepts `struct(gc)`s.
+        return StructView(runtime, std::exchange(*ptr, value), *type_info.value());
     }
 };
 }  // namespace mun
@@ -202,96 +548,234 @@ struct ReturnTypeReflection<StructRef> {
     static constexpr MunGuid type_guid() noexcept { return details::type_guid(type_name()); }
 };
 
-template <typename T>
-std::optional<T> StructRef::get(std::string_view field_name) const noexcept {
-    const auto type_info = info();
+template <>
+struct ArgumentReflection<StructView> {
+    static const char* type_name(const StructView& s) noexcept { return s.info()->name; }
+    static MunGuid type_guid(const StructView& s) noexcept { return s.info()->guid; }
+};
+
+template <>
+struct ReturnTypeReflection<StructView> : ReturnTypeReflection<StructRef> {};
 
+namespace details {
+/** The location and type of a struct field. */
+struct FieldInfo {
+    const MunTypeInfo* type;
+    size_t offset;
+};
+
+/** Finds the field corresponding to `field_name` in the struct `type_info`,
+ * and verifies that it can be marshalled as a `T`.
+ *
+ * \param runtime the runtime in which the struct was allocated
+ * \param type_info the type information of a struct
+ * \param field_name the name of the desired field
+ * \param out_error a pointer that will optionally return an error
+ * \return possibly, the location and type of the desired field
+ */
+template <typename T>
+std::optional<FieldInfo> find_field(const Runtime& runtime, const MunTypeInfo& type_info,
+                                    std::string_view field_name,
+                                    FieldError* out_error = nullptr) noexcept {
     // Safety: `type_info_as_struct` is guaranteed to return a value for
     // `StructRef`s.
-    const auto& struct_info = type_info->data.struct_;
-    if (const auto idx = details::find_index(type_info->name, struct_info, field_name)) {
+    const auto& struct_info = type_info.data.struct_;
+    if (const auto idx = find_index(runtime, type_info, field_name, out_error)) {
         const auto* field_type = struct_info.field_types[*idx];
         if (auto diff = reflection::equals_return_type<T>(*field_type)) {
-            const auto& [expected, found] = *diff;
-
-            std::cerr << "Mismatched types for `"
-                      << details::format_struct_field(type_info->name, field_name)
-                      << "`. Expected: `" << expected << "`. Found: `" << found << "`."
-                      << std::endl;
+            FieldError error{FieldErrorKind::TypeMismatch};
+            error.struct_type = type_info.name;
+            std::tie(error.expected_type, error.found_type) = *diff;
+            report_field_error(runtime, field_name, error, out_error);
 
             return std::nullopt;
         }
 
-        const auto offset = static_cast<size_t>(struct_info.field_offsets[*idx]);
-        const auto byte_ptr = reinterpret_cast<const std::byte*>(*raw());
-        return std::make_optional(Marshal<T>::copy_from(
-            reinterpret_cast<const typename Marshal<T>::type*>(byte_ptr + offset), *m_runtime,
-            field_type ? std::make_optional(field_type) : std::nullopt));
+        return std::make_optional(
+            FieldInfo{field_type, static_cast<size_t>(struct_info.field_offsets[*idx])});
     } else {
         return std::nullopt;
     }
 }
+}  // namespace details
+
+/** A field of a Mun struct that has been resolved in advance.
+ *
+ * The field's offset and type are looked up and verified once per struct type,
+ * after which the field is accessed at a fixed offset. The field is resolved
+ * again when it is accessed through a struct of a different type, or after the
+ * runtime was updated.
+ */
 template <typename T>
-std::optional<T> StructRef::replace(std::string_view field_name, T value) noexcept {
-    const auto type_info = info();
+class FieldAccessor {
+   public:
+    /** Constructs an accessor for the field corresponding to `field_name`.
+     *
+     * \param field_name the name of the desired field
+     */
+    explicit FieldAccessor(std::string_view field_name) noexcept : m_field_name(field_name) {}
 
-    // Safety: `type_info_as_struct` is guaranteed to return a value for
-    // `StructRef`s.
-    const auto& struct_info = type_info->data.struct_;
-    if (const auto idx = details::find_index(type_info->name, struct_info, field_name)) {
-        const auto* field_type = struct_info.field_types[*idx];
-        if (auto diff = reflection::equals_return_type<T>(*field_type)) {
-            const auto& [expected, found] = *diff;
+    /** Retrieves the name of the field. */
+    const std::string& field_name() const noexcept { return m_field_name; }
 
-            std::cerr << "Mismatched types for `"
-                      << details::format_struct_field(type_info->name, field_name)
-                      << "`. Expected: `" << expected << "`. Found: `" << found << "`."
-                      << std::endl;
+    /** Tries to retrieve the copied value of the field in `s`.
+     *
+     * \param s a struct
+     * \param out_error a pointer that will optionally return an error
+     * \return possibly, the value of the field
+     */
+    std::optional<T> get(StructView s, FieldError* out_error = nullptr) const noexcept {
+        if (!resolve(s, out_error)) {
+            return std::nullopt;
+        }
 
+        const auto byte_ptr = reinterpret_cast<const std::byte*>(*s.raw());
+        return std::make_optional(Marshal<T>::copy_from(
+            reinterpret_cast<const typename Marshal<T>::type*>(byte_ptr + m_offset), s.runtime(),
+            std::make_optional(m_field_type)));
+    }
+
+    /** Tries to replace the value of the field in `s`, returning its original
+     * value.
+     *
+     * \param s a struct
+     * \param value the new value of the field
+     * \param out_error a pointer that will optionally return an error
+     * \return possibly, the value of the replaced field
+     */
+    std::optional<T> replace(StructView s, T value,
+                             FieldError* out_error = nullptr) const noexcept {
+        if (!resolve(s, out_error)) {
             return std::nullopt;
         }
 
-        const auto offset = static_cast<size_t>(struct_info.field_offsets[*idx]);
-        auto byte_ptr = reinterpret_cast<std::byte*>(*raw());
+        auto byte_ptr = reinterpret_cast<std::byte*>(*s.raw());
         return std::make_optional(Marshal<T>::swap_at(
             Marshal<T>::to(std::move(value)),
-            reinterpret_cast<typename Marshal<T>::type*>(byte_ptr + offset), *m_runtime,
-            field_type ? std::make_optional(field_type) : std::nullopt));
-    } else {
-        return std::nullopt;
+            reinterpret_cast<typename Marshal<T>::type*>(byte_ptr + m_offset), s.runtime(),
+            std::make_optional(m_field_type)));
     }
-}
-template <typename T>
-bool StructRef::set(std::string_view field_name, T value) noexcept {
-    const auto type_info = info();
 
-    // Safety: `type_info_as_struct` is guaranteed to return a value for
-    // `StructRef`s.
-    const auto& struct_info = type_info->data.struct_;
-    if (const auto idx = details::find_index(type_info->name, struct_info, field_name)) {
-        const auto* field_type = struct_info.field_types[*idx];
-        if (auto diff = reflection::equals_return_type<T>(*field_type)) {
-            const auto& [expected, found] = *diff;
+    /** Tries to set the value of the field in `s` to the provided `value`.
+     *
+     * \param s a struct
+     * \param value the new value of the field
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the field was set successfully
+     */
+    bool set(StructView s, T value, FieldError* out_error = nullptr) const noexcept {
+        if (!resolve(s, out_error)) {
+            return false;
+        }
 
-            std::cerr << "Mismatched types for `"
-                      << details::format_struct_field(type_info->name, field_name)
-                      << "`. Expected: `" << expected << "`. Found: `" << found << "`."
-                      << std::endl;
+        auto byte_ptr = reinterpret_cast<std::byte*>(*s.raw());
+        Marshal<T>::move_to(Marshal<T>::to(std::move(value)),
+                            reinterpret_cast<typename Marshal<T>::type*>(byte_ptr + m_offset),
+                            std::make_optional(m_field_type));
+        return true;
+    }
 
-            return false;
+    /** Resolves the field for the type of `s`, if it was not already resolved.
+     *
+     * \param s a struct
+     * \param out_error a pointer that will optionally return an error
+     * \return whether `s` contains the field with a matching type
+     */
+    bool resolve(StructView s, FieldError* out_error = nullptr) const noexcept {
+        const auto type_info = s.info();
+        const auto generation = s.runtime().generation();
+        if (type_info != m_struct_type || generation != m_generation) {
+            m_struct_type = type_info;
+            m_generation = generation;
+            if (const auto field =
+                    details::find_field<T>(s.runtime(), *type_info, m_field_name, &m_error)) {
+                m_field_type = field->type;
+                m_offset = field->offset;
+            } else {
+                m_field_type = nullptr;
+            }
         }
 
-        const auto offset = static_cast<size_t>(struct_info.field_offsets[*idx]);
-        auto byte_ptr = reinterpret_cast<std::byte*>(*raw());
+        // A failure is only reported to the diagnostic sink when the field is
+        // resolved, but it is returned on every access.
+        if (!m_field_type && out_error) {
+            *out_error = m_error;
+        }
+        return m_field_type != nullptr;
+    }
+
+   private:
+    std::string m_field_name;
+    mutable const MunTypeInfo* m_struct_type = nullptr;
+    mutable const MunTypeInfo* m_field_type = nullptr;
+    mutable size_t m_offset = 0;
+    mutable uint64_t m_generation = 0;
+    mutable FieldError m_error{FieldErrorKind::FieldNotFound};
+};
 
+template <typename T>
+FieldAccessor<T> StructRef::field(std::string_view field_name) const noexcept {
+    FieldAccessor<T> accessor(field_name);
+    accessor.resolve(*this);
+    return accessor;
+}
+
+template <typename T>
+std::optional<T> StructView::get(std::string_view field_name,
+                                 FieldError* out_error) const noexcept {
+    const auto type_info = info();
+    if (const auto field = details::find_field<T>(*m_runtime, *type_info, field_name, out_error)) {
+        const auto byte_ptr = reinterpret_cast<const std::byte*>(*m_raw);
+        return std::make_optional(Marshal<T>::copy_from(
+            reinterpret_cast<const typename Marshal<T>::type*>(byte_ptr + field->offset),
+            *m_runtime, std::make_optional(field->type)));
+    } else {
+        return std::nullopt;
+    }
+}
+template <typename T>
+std::optional<T> StructView::replace(std::string_view field_name, T value,
+                                     FieldError* out_error) noexcept {
+    const auto type_info = info();
+    if (const auto field = details::find_field<T>(*m_runtime, *type_info, field_name, out_error)) {
+        auto byte_ptr = reinterpret_cast<std::byte*>(*m_raw);
+        return std::make_optional(Marshal<T>::swap_at(
+            Marshal<T>::to(std::move(value)),
+            reinterpret_cast<typename Marshal<T>::type*>(byte_ptr + field->offset), *m_runtime,
+            std::make_optional(field->type)));
+    } else {
+        return std::nullopt;
+    }
+}
+template <typename T>
+bool StructView::set(std::string_view field_name, T value, FieldError* out_error) noexcept {
+    const auto type_info = info();
+    if (const auto field = details::find_field<T>(*m_runtime, *type_info, field_name, out_error)) {
+        auto byte_ptr = reinterpret_cast<std::byte*>(*m_raw);
         Marshal<T>::move_to(Marshal<T>::to(std::move(value)),
-                            reinterpret_cast<typename Marshal<T>::type*>(byte_ptr + offset),
-                            field_type ? std::make_optional(field_type) : std::nullopt);
+                            reinterpret_cast<typename Marshal<T>::type*>(byte_ptr + field->offset),
+                            std::make_optional(field->type));
         return true;
     } else {
         return false;
     }
 }
+
+template <typename T>
+std::optional<T> StructRef::get(std::string_view field_name, FieldError* out_error) const noexcept {
+    return StructView(*this).get<T>(field_name, out_error);
+}
+template <typename T>
+std::optional<T> StructRef::replace(std::string_view field_name, T value,
+                                    FieldError* out_error) noexcept {
+    return StructView(*this).replace<T>(field_name, std::move(value), out_error);
+}
+template <typename T>
+bool StructRef::set(std::string_view field_name, T value, FieldError* out_error) noexcept {
+    return StructView(*this).set<T>(field_name, std::move(value), out_error);
+}
 }  // namespace mun
 
+#include "mun/struct_mirror.h"
+
 #endif
@@ -0,0 +1,210 @@
+#ifndef MUN_THREAD_POOL_H_
+#define MUN_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace mun {
+namespace details {
+/** A range-based job that is split into tasks, which are executed by the
+ * threads of a `ThreadPool`.
+ */
+struct PoolJob {
+    void (*run)(void* context, size_t begin, size_t end);
+    void* context;
+    std::atomic<size_t> remaining;
+};
+
+/** A sub-range of a `PoolJob`. */
+struct PoolTask {
+    PoolJob* job;
+    size_t begin;
+    size_t end;
+};
+
+/** A double-ended task queue. Its owner pops from the back, while other
+ * threads steal from the front.
+ */
+struct PoolQueue {
+    std::mutex mutex;
+    std::deque<PoolTask> tasks;
+};
+}  // namespace details
+
+/** A work-stealing thread pool for data-parallel loops.
+ *
+ * Every worker thread owns a task queue. Idle workers steal tasks from the
+ * queues of other workers, which balances uneven workloads.
+ */
+class ThreadPool {
+   public:
+    /** Constructs a thread pool with `num_workers` worker threads.
+     *
+     * The thread that calls `parallel_for` also executes tasks, so a pool
+     * without workers runs everything on the calling thread.
+     *
+     * \param num_workers the number of worker threads
+     */
+    explicit ThreadPool(size_t num_workers = default_num_workers()) noexcept {
+        // The last queue is shared by threads outside of the pool.
+        for (size_t idx = 0; idx <= num_workers; ++idx) {
+            m_queues.emplace_back(std::make_unique<details::PoolQueue>());
+        }
+
+        m_workers.reserve(num_workers);
+        for (size_t idx = 0; idx < num_workers; ++idx) {
+            m_workers.emplace_back([this, idx]() { work(idx); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /** Destructs the thread pool, after finishing all queued tasks. */
+    ~ThreadPool() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    /** Retrieves the number of worker threads. */
+    size_t num_workers() const noexcept { return m_workers.size(); }
+
+    /** Calls `fn(begin, end)` for consecutive sub-ranges of `[0, count)`,
+     * spread across the threads of the pool.
+     *
+     * Blocks until all sub-ranges have been processed. The calling thread
+     * processes sub-ranges while it waits.
+     *
+     * \param count the number of elements
+     * \param grain_size the maximum number of elements per sub-range
+     * \param fn a callable that processes a sub-range
+     */
+    template <typename F>
+    void parallel_for(size_t count, size_t grain_size, F&& fn) noexcept {
+        if (count == 0) {
+            return;
+        }
+
+        grain_size = std::max<size_t>(grain_size, 1);
+        const size_t num_tasks = (count + grain_size - 1) / grain_size;
+
+        using fn_type = std::remove_reference_t<F>;
+        details::PoolJob job{[](void* context, size_t begin, size_t end) {
+                                 (*static_cast<fn_type*>(context))(begin, end);
+                             },
+                             const_cast<void*>(static_cast<const void*>(&fn)), num_tasks};
+
+        const size_t num_queues = std::max<size_t>(m_workers.size(), 1);
+        for (size_t idx = 0; idx < num_tasks; ++idx) {
+            const size_t begin = idx * grain_size;
+            push(idx % num_queues,
+                 details::PoolTask{&job, begin, std::min(begin + grain_size, count)});
+        }
+
+        {
+            // Prevents a lost wake-up of workers that are about to wait.
+            std::lock_guard<std::mutex> lock(m_mutex);
+        }
+        m_cv.notify_all();
+
+        while (job.remaining.load(std::memory_order_acquire) > 0) {
+            if (!run_one(m_queues.size() - 1)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+   private:
+    static size_t default_num_workers() noexcept {
+        const size_t concurrency = std::thread::hardware_concurrency();
+        return concurrency > 1 ? concurrency - 1 : 0;
+    }
+
+    void push(size_t queue_idx, details::PoolTask task) noexcept {
+        auto& queue = *m_queues[queue_idx];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+        m_num_queued.fetch_add(1, std::memory_order_release);
+    }
+
+    bool pop(size_t queue_idx, bool steal, details::PoolTask& out_task) noexcept {
+        auto& queue = *m_queues[queue_idx];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+
+        if (steal) {
+            out_task = queue.tasks.front();
+            queue.tasks.pop_front();
+        } else {
+            out_task = queue.tasks.back();
+            queue.tasks.pop_back();
+        }
+        m_num_queued.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    /** Runs a task from the queue at `self`, or steals one from another queue.
+     *
+     * \return whether a task was run
+     */
+    bool run_one(size_t self) noexcept {
+        details::PoolTask task;
+        bool found = pop(self, false, task);
+        for (size_t offset = 1; !found && offset < m_queues.size(); ++offset) {
+            found = pop((self + offset) % m_queues.size(), true, task);
+        }
+
+        if (!found) {
+            return false;
+        }
+
+        task.job->run(task.job->context, task.begin, task.end);
+
+        // The job can be destroyed as soon as its last task completes.
+        task.job->remaining.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    void work(size_t self) noexcept {
+        while (true) {
+            if (run_one(self)) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() {
+                return m_stop || m_num_queued.load(std::memory_order_acquire) > 0;
+            });
+            if (m_stop && m_num_queued.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<details::PoolQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<size_t> m_num_queued{0};
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stop = false;
+};
+}  // namespace mun
+
+#endif
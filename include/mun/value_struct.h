@@ -0,0 +1,277 @@
+#ifndef MUN_VALUE_STRUCT_H_
+#define MUN_VALUE_STRUCT_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "mun/diagnostics.h"
+#include "mun/marshal.h"
+#include "mun/reflection.h"
+#include "mun/runtime.h"
+#include "mun/struct_ref.h"
+
+namespace mun {
+/** An owning copy of a Mun `struct(value)`, stored outside of the garbage
+ * collected heap.
+ *
+ * Structs of up to `INLINE_CAPACITY` bytes are stored inline; larger structs
+ * are stored in a separate heap allocation. Unlike marshalling a
+ * `struct(value)` as a `StructRef`, reading it from a field or passing it to a
+ * function does not allocate a garbage collected object, so short-lived values
+ * do not create garbage.
+ *
+ * A value struct does not root the `struct(gc)`s that its fields refer to.
+ * Updating the runtime can invalidate its type information, leading to
+ * undefined behavior when it is accessed.
+ */
+class ValueStruct {
+   public:
+    /** The maximum size in bytes of a struct that is stored inline. */
+    static constexpr size_t INLINE_CAPACITY = 64;
+
+    /** Constructs a `ValueStruct` by copying the memory of a Mun struct.
+     *
+     * \param runtime a reference to the runtime in which the struct type was
+     * defined
+     * \param type_info the type information of a `struct(value)`
+     * \param data a pointer to the memory of the struct
+     */
+    ValueStruct(const Runtime& runtime, const MunTypeInfo& type_info, const void* data) noexcept
+        : m_runtime(&runtime),
+          m_type_info(&type_info),
+          m_size(type_info_size_in_bytes(type_info)) {
+        assert(type_info.data.tag == MunTypeInfoData_Tag::Struct &&
+               type_info.data.struct_.memory_kind == MunStructMemoryKind::Value);
+        init(data);
+    }
+
+    /** Constructs a `ValueStruct` by copying the memory of a garbage collected
+     * `struct(value)`.
+     *
+     * \param s a struct
+     */
+    explicit ValueStruct(StructView s) noexcept : ValueStruct(s.runtime(), *s.info(), *s.raw()) {}
+
+    /** Copy constructs a `ValueStruct`.
+     *
+     * \param other a reference to a value struct
+     */
+    ValueStruct(const ValueStruct& other) noexcept
+        : m_runtime(other.m_runtime), m_type_info(other.m_type_info), m_size(other.m_size) {
+        init(other.m_data);
+    }
+
+    /** Move constructs a `ValueStruct`, taking ownership of a separate heap
+     * allocation.
+     *
+     * \param other an rvalue reference to a value struct
+     */
+    ValueStruct(ValueStruct&& other) noexcept
+        : m_runtime(other.m_runtime), m_type_info(other.m_type_info), m_size(other.m_size) {
+        take(other);
+    }
+
+    /** Copy assigns a `ValueStruct`.
+     *
+     * \param other a reference to a value struct
+     * \return a reference to this instance
+     */
+    ValueStruct& operator=(const ValueStruct& other) noexcept {
+        if (this != &other) {
+            release();
+            m_runtime = other.m_runtime;
+            m_type_info = other.m_type_info;
+            m_size = other.m_size;
+            init(other.m_data);
+        }
+        return *this;
+    }
+
+    /** Move assigns a `ValueStruct`.
+     *
+     * \param other an rvalue reference to a value struct
+     * \return a reference to this instance
+     */
+    ValueStruct& operator=(ValueStruct&& other) noexcept {
+        if (this != &other) {
+            release();
+            m_runtime = other.m_runtime;
+            m_type_info = other.m_type_info;
+            m_size = other.m_size;
+            take(other);
+        }
+        return *this;
+    }
+
+    /** Destructs the `ValueStruct`, freeing a separate heap allocation. */
+    ~ValueStruct() noexcept { release(); }
+
+    /** Retrieves a garbage collection handle that refers to the struct's
+     * memory.
+     *
+     * The handle is only valid while this instance is neither moved nor
+     * destroyed, and must not be passed to functions of the runtime's garbage
+     * collector.
+     *
+     * \return a handle to the struct's memory
+     */
+    MunGcPtr raw() const noexcept { return &m_data; }
+
+    /** Retrieves a pointer to the struct's memory. */
+    void* data() noexcept { return m_data; }
+    const void* data() const noexcept { return m_data; }
+
+    /** Retrieves the type information of the struct.
+     *
+     * \return a pointer to the struct's type information
+     */
+    const MunTypeInfo* info() const noexcept { return m_type_info; }
+
+    /** Retrieves the runtime in which the struct type was defined. */
+    const Runtime& runtime() const noexcept { return *m_runtime; }
+
+    /** Retrieves the size of the struct in bytes. */
+    size_t size_in_bytes() const noexcept { return m_size; }
+
+    /** Retrieves whether the struct is stored inline. */
+    bool is_inline() const noexcept { return m_data == m_inline; }
+
+    /** Copies the struct into a new garbage collected object.
+     *
+     * \param out_error a pointer that will optionally return an error
+     * \return possibly, a rooted copy of the struct
+     */
+    std::optional<StructRef> to_ref(Error* out_error = nullptr) const noexcept {
+        const auto obj = m_runtime->gc_alloc(const_cast<MunUnsafeTypeInfo>(m_type_info), out_error);
+        if (!obj) {
+            return std::nullopt;
+        }
+
+        std::memcpy(**obj, m_data, size_in_bytes());
+        return std::make_optional<StructRef>(*m_runtime, *obj, *m_type_info);
+    }
+
+    /** Tries to retrieve the copied value of the field corresponding to
+     * `field_name`.
+     *
+     * \param field_name the name of the desired field
+     * \param out_error a pointer that will optionally return an error
+     * \return possibly, the value of the desired field
+     */
+    template <typename T>
+    std::optional<T> get(std::string_view field_name,
+                         FieldError* out_error = nullptr) const noexcept {
+        return view().get<T>(field_name, out_error);
+    }
+
+    /** Tries to replace the value of the field corresponding to
+     * `field_name`, returning its original value.
+     *
+     * \param field_name the name of the desired field
+     * \param value the new value of the field
+     * \param out_error a pointer that will optionally return an error
+     * \return possibly, the value of the replaced field
+     */
+    template <typename T>
+    std::optional<T> replace(std::string_view field_name, T value,
+                             FieldError* out_error = nullptr) noexcept {
+        return view().replace<T>(field_name, std::move(value), out_error);
+    }
+
+    /** Tries to set the value of the field corresponding to
+     * `field_name` to the provided `value`.
+     *
+     * \param field_name the name of the desired field
+     * \param value the new value of the field
+     * \param out_error a pointer that will optionally return an error
+     * \return whether the field was set successfully
+     */
+    template <typename T>
+    bool set(std::string_view field_name, T value, FieldError* out_error = nullptr) noexcept {
+        return view().set<T>(field_name, std::move(value), out_error);
+    }
+
+   private:
+    StructView view() const noexcept { return StructView(*m_runtime, raw(), *m_type_info); }
+
+    void init(const void* data) noexcept {
+        m_data = m_size <= INLINE_CAPACITY ? static_cast<void*>(m_inline) : std::malloc(m_size);
+        std::memcpy(m_data, data, m_size);
+    }
+
+    void take(ValueStruct& other) noexcept {
+        if (other.is_inline()) {
+            m_data = m_inline;
+            std::memcpy(m_data, other.m_data, m_size);
+        } else {
+            m_data = std::exchange(other.m_data, other.m_inline);
+        }
+    }
+
+    void release() noexcept {
+        if (!is_inline()) {
+            std::free(m_data);
+            m_data = m_inline;
+        }
+    }
+
+    alignas(std::max_align_t) std::byte m_inline[INLINE_CAPACITY];
+    const Runtime* m_runtime;
+    const MunTypeInfo* m_type_info;
+    // Cached so that the struct can be freed after a reload invalidated its type
+    size_t m_size;
+    void* m_data;
+};
+
+template <>
+struct Marshal<ValueStruct> {
+    using type = MunGcPtr;
+
+    static ValueStruct from(type ptr, const Runtime& runtime) noexcept {
+        return ValueStruct(runtime, *runtime.ptr_type(ptr), *ptr);
+    }
+
+    static type to(const ValueStruct& value) noexcept { return value.raw(); }
+
+    static ValueStruct copy_from(const type* ptr, const Runtime& runtime,
+                                 std::optional<const MunTypeInfo*> type_info) noexcept {
+        // Safety: `type_info_as_struct` is guaranteed to return a value for
+        // `ValueStruct`s, and `equals_return_type` only accepts
+        // `struct(value)`s, which are stored inline.
+        return ValueStruct(runtime, *type_info.value(), ptr);
+    }
+
+    static void move_to(type value, type* ptr,
+                        std::optional<const MunTypeInfo*> type_info) noexcept {
+        details::move_struct_to(value, ptr, *type_info.value());
+    }
+
+    static ValueStruct swap_at(type value, type* ptr, const Runtime& runtime,
+                               std::optional<const MunTypeInfo*> type_info) noexcept {
+        ValueStruct original(runtime, *type_info.value(), ptr);
+        details::move_struct_to(value, ptr, *type_info.value());
+        return original;
+    }
+};
+
+template <>
+struct ArgumentReflection<ValueStruct> {
+    static const char* type_name(const ValueStruct& s) noexcept { return s.info()->name; }
+    static MunGuid type_guid(const ValueStruct& s) noexcept { return s.info()->guid; }
+};
+
+template <>
+struct ReturnTypeReflection<ValueStruct> {
+    static constexpr const char* type_name() noexcept { return "struct(value)"; }
+    static constexpr MunGuid type_guid() noexcept {
+        return ReturnTypeReflection<StructRef>::type_guid();
+    }
+};
+}  // namespace mun
+
+#endif
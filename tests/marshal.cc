@@ -226,3 +226,304 @@ TEST_CASE("struct can get, set, and replace struct", "[marshal]") {
         FAIL(err.message());
     }
 }
+
+TEST_CASE("struct can get, set, and replace value structs", "[marshal]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        float a = -3.14f, b = 6.28f;
+        auto gc_struct = mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_struct", a, b).wait();
+        auto value = mun::invoke_fn<mun::ValueStruct>(*runtime, "new_value_struct", a, b).wait();
+        REQUIRE(value.is_inline());
+        REQUIRE(value.get<float>("0") == a);
+        REQUIRE(value.get<float>("1") == b);
+
+        // Pass a value struct to Mun without copying it to the heap
+        auto s =
+            mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_wrapper", gc_struct, value).wait();
+
+        auto value2 = s.get<mun::ValueStruct>("1");
+        REQUIRE(value2.has_value());
+        REQUIRE(value2->info() == value.info());
+        REQUIRE(value2->set("0", b));
+        REQUIRE(value2->set("1", a));
+
+        // Verify that a value struct is a copy
+        REQUIRE(s.get<float>("1") == std::nullopt);
+        const auto copy = s.get<mun::StructRef>("1");
+        REQUIRE(copy.has_value());
+        REQUIRE(copy->get<float>("0") == a);
+
+        // Replace the value-struct's content.
+        auto value3 = s.replace("1", *value2);
+        REQUIRE(value3.has_value());
+        REQUIRE(value3->get<float>("0") == a);
+        REQUIRE(value3->get<float>("1") == b);
+
+        // Set the value-struct's content.
+        REQUIRE(s.set("1", *value3));
+        auto value4 = s.get<mun::ValueStruct>("1");
+        REQUIRE(value4.has_value());
+        REQUIRE(value4->get<float>("0") == a);
+
+        const auto ref = value4->to_ref();
+        REQUIRE(ref.has_value());
+        REQUIRE(ref->get<float>("1") == b);
+
+        // A `struct(gc)` is not a value struct
+        mun::FieldError field_error{mun::FieldErrorKind::FieldNotFound};
+        REQUIRE(!s.get<mun::ValueStruct>("0", &field_error).has_value());
+        REQUIRE(field_error.kind == mun::FieldErrorKind::TypeMismatch);
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("struct fields can be accessed through field accessors", "[marshal]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        float a = -3.14f, b = 6.28f;
+        auto gc_struct = mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_struct", a, b).wait();
+        auto value_struct =
+            mun::invoke_fn<mun::StructRef>(*runtime, "new_value_struct", a, b).wait();
+        auto gc_wrapper = mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_wrapper", gc_struct,
+                                                         value_struct)
+                              .wait();
+
+        auto first = gc_struct.field<float>("0");
+        auto second = mun::FieldAccessor<float>("1");
+        REQUIRE(first.get(gc_struct) == a);
+        REQUIRE(second.get(gc_struct) == b);
+
+        REQUIRE(first.set(gc_struct, b));
+        REQUIRE(second.replace(gc_struct, a) == b);
+        REQUIRE(gc_struct.get<float>("0") == b);
+        REQUIRE(gc_struct.get<float>("1") == a);
+
+        // Accessors re-resolve when used with a struct of a different type
+        REQUIRE(first.get(value_struct) == a);
+        REQUIRE(second.get(value_struct) == b);
+
+        auto gc_field = gc_wrapper.field<mun::StructRef>("0");
+        auto gc = gc_field.get(gc_wrapper);
+        REQUIRE(gc.has_value());
+        REQUIRE(first.get(*gc) == b);
+
+        // Accessors fail for missing fields and mismatched types
+        REQUIRE(!mun::FieldAccessor<float>("2").get(gc_struct).has_value());
+        REQUIRE(!mun::FieldAccessor<int32_t>("0").get(gc_struct).has_value());
+        REQUIRE(!first.get(gc_wrapper).has_value());
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("struct fields can be accessed through field paths", "[marshal]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        float a = -3.14f, b = 6.28f;
+        auto gc_struct = mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_struct", a, b).wait();
+        auto value_struct =
+            mun::invoke_fn<mun::StructRef>(*runtime, "new_value_struct", a, b).wait();
+        std::array<mun::StructRef, 2> structs = {
+            mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_wrapper", gc_struct, value_struct)
+                .wait(),
+            mun::invoke_fn<mun::StructRef>(*runtime, "new_value_wrapper", gc_struct,
+                                           value_struct)
+                .wait()};
+
+        // Through a `struct(gc)` and a `struct(value)`, respectively
+        mun::FieldPath<float> gc_second("0.1");
+        mun::FieldPath<float> value_first("1.0");
+        for (auto& s : structs) {
+            REQUIRE(gc_second.get(s) == b);
+            REQUIRE(value_first.get(s) == a);
+
+            REQUIRE(gc_second.set(s, a));
+            REQUIRE(value_first.replace(s, b) == a);
+
+            REQUIRE(s.get<mun::StructRef>("0")->get<float>("1") == a);
+            REQUIRE(s.get<mun::StructRef>("1")->get<float>("0") == b);
+
+            REQUIRE(gc_second.set(s, b));
+            REQUIRE(value_first.set(s, a));
+        }
+
+        // The `struct(gc)` is shared by both wrappers
+        REQUIRE(gc_struct.get<float>("1") == b);
+
+        mun::FieldError field_error{mun::FieldErrorKind::TypeMismatch};
+        REQUIRE(!mun::FieldPath<float>("0.2").get(structs[0], &field_error).has_value());
+        REQUIRE(field_error.kind == mun::FieldErrorKind::FieldNotFound);
+
+        field_error.kind = mun::FieldErrorKind::FieldNotFound;
+        REQUIRE(!mun::FieldPath<float>("0.1.0").get(structs[0], &field_error).has_value());
+        REQUIRE(field_error.kind == mun::FieldErrorKind::TypeMismatch);
+
+        field_error.kind = mun::FieldErrorKind::FieldNotFound;
+        REQUIRE(!mun::FieldPath<int32_t>("1.0").get(structs[1], &field_error).has_value());
+        REQUIRE(field_error.kind == mun::FieldErrorKind::TypeMismatch);
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("struct can be accessed through views", "[marshal]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        float a = -3.14f, b = 6.28f;
+        auto gc_struct = mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_struct", a, b).wait();
+        auto value_struct =
+            mun::invoke_fn<mun::StructRef>(*runtime, "new_value_struct", a, b).wait();
+        auto gc_wrapper = mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_wrapper", gc_struct,
+                                                         value_struct)
+                              .wait();
+
+        mun::GcNoCollectScope no_collect(*runtime);
+        REQUIRE(runtime->is_gc_collect_blocked());
+        REQUIRE(!runtime->gc_collect());
+
+        mun::StructView view = gc_struct;
+        REQUIRE(view.raw() == gc_struct.raw());
+        REQUIRE(view.info() == runtime->ptr_type(gc_struct.raw()));
+        REQUIRE(gc_struct.info() == runtime->ptr_type(gc_struct.raw()));
+        REQUIRE(view.get<float>("0") == a);
+        REQUIRE(view.set("0", b));
+        REQUIRE(view.replace("1", a) == b);
+        REQUIRE(gc_struct.get<float>("0") == b);
+        REQUIRE(gc_struct.get<float>("1") == a);
+
+        // Views of unrooted fields stay valid while garbage is not collected
+        auto inner = mun::StructView(gc_wrapper).get<mun::StructView>("0");
+        REQUIRE(inner.has_value());
+        REQUIRE(inner->raw() == gc_struct.raw());
+        REQUIRE(mun::FieldAccessor<float>("1").get(*inner) == a);
+
+        // Value structs are copied, so they cannot be retrieved as views
+        mun::FieldError field_error;
+        REQUIRE(!mun::StructView(gc_wrapper).get<mun::StructView>("1", &field_error));
+        REQUIRE(field_error.kind == mun::FieldErrorKind::TypeMismatch);
+
+        // Views can be passed as arguments
+        auto wrapper = mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_wrapper", view,
+                                                      mun::StructView(value_struct));
+        REQUIRE(wrapper.is_ok());
+        REQUIRE(view.to_ref().raw() == gc_struct.raw());
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+MUN_STRUCT(GcStructMirror, (float, first), (float, second));
+MUN_STRUCT(GcStructIntMirror, (float, first), (int32_t, second));
+
+TEST_CASE("struct mirrors verify their layout", "[marshal]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        static_assert(GcStructMirror::mun_fields().size() == 2);
+        static_assert(GcStructMirror::mun_fields()[1].offset == offsetof(GcStructMirror, second));
+
+        // The fields of a tuple struct are matched by position
+        auto s = mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_struct", 1.0f, 2.0f).wait();
+        auto ptr = mun::make_gc_ptr<GcStructMirror>(s);
+        REQUIRE(ptr.has_value());
+        REQUIRE((*ptr)->first == 1.0f);
+        (*ptr)->second = 3.0f;
+        REQUIRE(s.get<float>("1") == 3.0f);
+
+        mun::FieldError field_error{mun::FieldErrorKind::FieldNotFound};
+        REQUIRE(!mun::make_gc_ptr<GcStructIntMirror>(s, &field_error).has_value());
+        REQUIRE(field_error.kind == mun::FieldErrorKind::TypeMismatch);
+        REQUIRE(field_error.struct_type == s.info()->name);
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("struct can be loaded and stored as a whole", "[marshal]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        auto s = mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_struct", 1.0f, 2.0f).wait();
+        GcStructMirror mirror{};
+        REQUIRE(s.load_into(mirror));
+        REQUIRE(mirror.first == 1.0f);
+        REQUIRE(mirror.second == 2.0f);
+
+        REQUIRE(s.store_from(GcStructMirror{3.0f, 4.0f}));
+        REQUIRE(s.get<float>("0") == 3.0f);
+        REQUIRE(s.get<float>("1") == 4.0f);
+
+        GcStructIntMirror int_mirror{};
+        REQUIRE(!s.load_into(int_mirror));
+
+        std::vector<mun::StructRef> structs{
+            s, mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_struct", 5.0f, 6.0f).wait()};
+        std::vector<GcStructMirror> mirrors(structs.size());
+        REQUIRE(mun::load_into<GcStructMirror>(structs, mirrors));
+        REQUIRE(mirrors[1].first == 5.0f);
+        REQUIRE(mirrors[1].second == 6.0f);
+
+        mirrors[0].first = 7.0f;
+        REQUIRE(mun::store_from<GcStructMirror>(structs, mirrors));
+        REQUIRE(s.get<float>("0") == 7.0f);
+
+        mirrors.pop_back();
+        REQUIRE(!mun::store_from<GcStructMirror>(structs, mirrors));
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("struct reports field errors", "[marshal]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        size_t num_reported = 0;
+        mun::DiagnosticSink sink;
+        sink.user_data = &num_reported;
+        sink.on_field_error = [](std::string_view, const mun::FieldError&, void* user_data) {
+            ++*static_cast<size_t*>(user_data);
+        };
+        runtime->set_diagnostic_sink(sink);
+
+        auto s = mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_struct", 1.0f, 2.0f).wait();
+
+        mun::FieldError field_error{mun::FieldErrorKind::TypeMismatch};
+        REQUIRE(!s.get<float>("2", &field_error).has_value());
+        REQUIRE(field_error.kind == mun::FieldErrorKind::FieldNotFound);
+
+        REQUIRE(!s.set<int32_t>("0", 1, &field_error));
+        REQUIRE(field_error.kind == mun::FieldErrorKind::TypeMismatch);
+        REQUIRE(std::string_view(field_error.expected_type) == "core::f32");
+        REQUIRE(std::string_view(field_error.found_type) == "core::i32");
+
+        auto accessor = mun::FieldAccessor<int32_t>("1");
+        REQUIRE(!accessor.get(s).has_value());
+        REQUIRE(!accessor.replace(s, 1, &field_error).has_value());
+        REQUIRE(field_error.kind == mun::FieldErrorKind::TypeMismatch);
+
+        // Accessors only report when the field is resolved
+        REQUIRE(num_reported == 3);
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
@@ -0,0 +1,93 @@
+#include <mun/mun.h>
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/// Returns the absolute path to the munlib with the specified name
+inline std::string get_munlib_path(std::string_view name) {
+    std::stringstream ss;
+    ss << MUN_TEST_DIR << name;
+    return ss.str();
+}
+
+TEST_CASE("thread pool processes every element once", "[parallel]") {
+    for (size_t num_workers : {0, 1, 4}) {
+        mun::ThreadPool pool(num_workers);
+        REQUIRE(pool.num_workers() == num_workers);
+
+        std::vector<std::atomic<int>> counts(10000);
+        pool.parallel_for(counts.size(), 7, [&](size_t begin, size_t end) {
+            for (size_t idx = begin; idx < end; ++idx) {
+                counts[idx].fetch_add(1);
+            }
+        });
+
+        for (const auto& count : counts) {
+            REQUIRE(count.load() == 1);
+        }
+    }
+}
+
+TEST_CASE("functions can be invoked in parallel", "[parallel]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        constexpr size_t COUNT = 100000;
+        std::vector<int64_t> lhs(COUNT), rhs(COUNT), out(COUNT);
+        for (size_t idx = 0; idx < COUNT; ++idx) {
+            lhs[idx] = static_cast<int64_t>(idx);
+            rhs[idx] = static_cast<int64_t>(2 * idx);
+        }
+
+        mun::ThreadPool pool(4);
+        REQUIRE(mun::invoke_parallel<int64_t, int64_t, int64_t>(pool, *runtime, "marshal_int64_t",
+                                                                out, lhs, rhs));
+        for (size_t idx = 0; idx < COUNT; ++idx) {
+            REQUIRE(out[idx] == lhs[idx] + rhs[idx]);
+        }
+
+        // Mismatching signature
+        std::vector<float> float_out(COUNT);
+        REQUIRE(!mun::invoke_parallel<float, int64_t, int64_t>(pool, *runtime, "marshal_int64_t",
+                                                               float_out, lhs, rhs));
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("structs can be rooted and accessed concurrently", "[parallel]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        const float a = -3.14f, b = 6.28f;
+        auto s = mun::invoke_fn<mun::StructRef>(*runtime, "new_gc_struct", a, b).wait();
+
+        std::atomic<bool> success(true);
+        std::vector<std::thread> threads;
+        for (size_t thread_idx = 0; thread_idx < 4; ++thread_idx) {
+            threads.emplace_back([&]() {
+                for (size_t idx = 0; idx < 1000; ++idx) {
+                    // Copying a `StructRef` roots the object; destroying it unroots it.
+                    const mun::StructRef copy = s;
+                    if (copy.info() != s.info() || copy.get<float>("0") != a ||
+                        copy.get<float>("1") != b) {
+                        success = false;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        REQUIRE(success);
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
@@ -1,7 +1,12 @@
 #include <mun/mun.h>
 
+#include <array>
+#include <atomic>
 #include <catch2/catch.hpp>
+#include <filesystem>
 #include <sstream>
+#include <thread>
+#include <type_traits>
 
 /// Returns the absolute path to the munlib with the specified name
 inline std::string get_munlib_path(std::string_view name) {
@@ -55,6 +60,21 @@ TEST_CASE("runtime can update", "[runtime]") {
     }
 }
 
+TEST_CASE("runtime can wait for updates", "[runtime]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("fibonacci/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        // Without changes on disk, waiting times out.
+        REQUIRE(!runtime->wait_for_update(std::chrono::milliseconds(20), &err));
+        REQUIRE(!err);
+        REQUIRE(runtime->generation() == 0);
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
 TEST_CASE("runtime can garbage collect", "[runtime]") {
     mun::Error err;
     if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
@@ -70,3 +90,554 @@ TEST_CASE("runtime can garbage collect", "[runtime]") {
         FAIL(err.message());
     }
 }
+
+TEST_CASE("runtime can share roots", "[runtime]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+        {
+            auto s = mun::invoke_fn<mun::StructRef>(*runtime, "new_bool", true, false).unwrap();
+            REQUIRE(!s.is_shared());
+
+            std::vector<mun::StructRef> copies(4, s.share());
+            REQUIRE(s.is_shared());
+            REQUIRE(copies[0].raw() == s.raw());
+            REQUIRE(copies[0].is_shared());
+
+            // The shared root keeps the object alive until its last copy is destroyed
+            s = mun::invoke_fn<mun::StructRef>(*runtime, "new_bool", false, true).unwrap();
+            REQUIRE(runtime->gc_collect() == false);
+            REQUIRE(copies.back().get<bool>("0") == true);
+            copies.clear();
+            REQUIRE(runtime->gc_collect());
+        }
+
+        auto s = mun::invoke_fn<mun::StructRef>(*runtime, "new_bool", true, false).unwrap();
+        mun::SharedGcRoot root(*runtime, s.raw());
+        REQUIRE(root.use_count() == 1);
+        {
+            auto copy = root;
+            REQUIRE(copy.handle() == s.raw());
+            REQUIRE(root.use_count() == 2);
+        }
+        REQUIRE(root.use_count() == 1);
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("runtime can root objects in bulk", "[runtime]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        mun::RootSet roots(*runtime);
+        {
+            std::vector<MunGcPtr> objs;
+            for (int32_t idx = 0; idx < 16; ++idx) {
+                auto s = mun::invoke_fn<mun::StructRef>(*runtime, "new_int32_t", idx, idx).unwrap();
+                objs.push_back(s.raw());
+            }
+            REQUIRE(roots.insert(objs, &err));
+            REQUIRE(!err);
+        }
+        REQUIRE(roots.size() == 16);
+
+        // The root set keeps the objects alive
+        REQUIRE(!runtime->gc_collect());
+        for (size_t idx = 0; idx < roots.size(); ++idx) {
+            REQUIRE(mun::StructView(*runtime, roots[idx]).get<int32_t>("0") ==
+                    static_cast<int32_t>(idx));
+        }
+
+        REQUIRE(roots.clear(&err));
+        REQUIRE(!err);
+        REQUIRE(roots.empty());
+        REQUIRE(runtime->gc_collect());
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("runtime can allocate objects in bulk", "[runtime]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        const auto type_info =
+            mun::invoke_fn<mun::StructRef>(*runtime, "new_int32_t", 0, 0).unwrap().info();
+
+        std::array<MunGcPtr, 4> objs{};
+        REQUIRE(runtime->gc_alloc_many(type_info, objs, &err));
+        REQUIRE(!err);
+        for (auto obj : objs) {
+            REQUIRE(runtime->ptr_type(obj) == type_info);
+        }
+
+        mun::RootSet roots(*runtime);
+        auto allocated = roots.alloc(type_info, 16, &err);
+        REQUIRE(allocated.has_value());
+        REQUIRE(!err);
+        REQUIRE(allocated->size() == 16);
+        REQUIRE(roots.size() == 16);
+        for (size_t idx = 0; idx < allocated->size(); ++idx) {
+            REQUIRE(mun::StructView(*runtime, (*allocated)[idx])
+                        .set("0", static_cast<int32_t>(idx)));
+        }
+
+        // Only the unrooted objects are collected
+        REQUIRE(runtime->gc_collect());
+        for (size_t idx = 0; idx < roots.size(); ++idx) {
+            REQUIRE(mun::StructView(*runtime, roots[idx]).get<int32_t>("0") ==
+                    static_cast<int32_t>(idx));
+        }
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("runtime reports garbage collection statistics", "[runtime]") {
+    mun::Error err;
+    mun::RuntimeOptions options;
+    options.gc_type_stats = true;
+    if (auto runtime =
+            mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), options, &err)) {
+        REQUIRE(!err);
+
+        auto stats = runtime->gc_stats();
+        REQUIRE(stats.num_allocations == 0);
+        REQUIRE(stats.num_roots == 0);
+        REQUIRE(stats.num_collections == 0);
+
+        auto s = mun::invoke_fn<mun::StructRef>(*runtime, "new_int32_t", 0, 0).unwrap();
+        const auto type_info = s.info();
+        REQUIRE(runtime->gc_stats().num_roots == 1);
+        {
+            mun::RootSet roots(*runtime);
+            REQUIRE(roots.alloc(type_info, 8, &err));
+            REQUIRE(runtime->gc_alloc(type_info, &err));
+
+            stats = runtime->gc_stats();
+            REQUIRE(stats.num_allocations == 9);
+            REQUIRE(stats.bytes_allocated == 9 * mun::type_info_size_in_bytes(*type_info));
+            REQUIRE(stats.types.size() == 1);
+            REQUIRE(stats.types[0].type_name == type_info->name);
+            REQUIRE(stats.types[0].num_allocations == 9);
+            REQUIRE(stats.num_roots == 9);
+        }
+        REQUIRE(runtime->gc_stats().num_roots == 1);
+
+        REQUIRE(runtime->gc_collect());
+        REQUIRE(!runtime->gc_collect());
+        stats = runtime->gc_stats();
+        REQUIRE(stats.num_collections == 2);
+        REQUIRE(stats.num_reclaiming_collections == 1);
+        REQUIRE(stats.total_collection_time >= stats.last_collection_time);
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("runtime can collect garbage within a time budget", "[runtime]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        using namespace std::chrono_literals;
+
+        // Without previous collections, garbage is always collected
+        REQUIRE(runtime->gc_collect_if_within(0us) == 0ns);
+        REQUIRE(runtime->gc_stats().num_collections == 1);
+
+        REQUIRE(runtime->gc_collect_if_within(1s) == 0ns);
+        REQUIRE(runtime->gc_stats().num_collections == 2);
+
+        // A collection that does not fit in the budget is deferred
+        if (runtime->gc_stats().last_collection_time > 0ns) {
+            REQUIRE(runtime->gc_collect_if_within(0us) > 0ns);
+            REQUIRE(runtime->gc_stats().num_collections == 2);
+        }
+
+        {
+            mun::GcNoCollectScope scope(*runtime);
+            REQUIRE(runtime->gc_collect_if_within(1s) > 0ns);
+        }
+        REQUIRE(runtime->gc_stats().num_collections == 2);
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("runtime can collect garbage in the background", "[runtime]") {
+    mun::Error err;
+    mun::RuntimeOptions options;
+    options.background_gc = true;
+    options.background_gc_interval_ms = 1;
+    if (auto runtime =
+            mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), options, &err)) {
+        REQUIRE(!err);
+        REQUIRE(runtime->has_background_gc());
+
+        using namespace std::chrono_literals;
+
+        mun::MutatorScope mutator(*runtime);
+
+        // Without safepoints, the mutator prevents collections
+        REQUIRE(mun::invoke_fn<mun::StructRef>(*runtime, "new_int32_t", 0, 0).is_ok());
+        std::this_thread::sleep_for(20ms);
+        REQUIRE(runtime->gc_stats().num_collections == 0);
+
+        while (runtime->gc_stats().num_collections == 0) {
+            runtime->safepoint();
+        }
+
+        auto num_collections = runtime->gc_stats().num_collections;
+        {
+            mun::Safepoint safepoint(*runtime);
+            std::this_thread::sleep_for(20ms);
+        }
+        REQUIRE(runtime->gc_stats().num_collections > num_collections);
+
+        // Waiting for an update parks the mutator
+        num_collections = runtime->gc_stats().num_collections;
+        REQUIRE(!runtime->wait_for_update(20ms));
+        REQUIRE(runtime->gc_stats().num_collections > num_collections);
+
+        // Polling inside a safe region does not park the mutator twice, so
+        // other mutators still prevent collections
+        {
+            mun::Safepoint safepoint(*runtime);
+            std::atomic<bool> is_attached{false};
+            std::atomic<bool> is_done{false};
+            std::thread other([&]() {
+                mun::MutatorScope other_mutator(*runtime);
+                is_attached = true;
+                while (!is_done) {
+                    std::this_thread::yield();
+                }
+            });
+            while (!is_attached) {
+                std::this_thread::yield();
+            }
+
+            num_collections = runtime->gc_stats().num_collections;
+            const auto end = std::chrono::steady_clock::now() + 20ms;
+            while (std::chrono::steady_clock::now() < end) {
+                runtime->safepoint();
+            }
+            REQUIRE(runtime->gc_stats().num_collections == num_collections);
+
+            is_done = true;
+            other.join();
+        }
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("runtime collects garbage when crossing allocation thresholds", "[runtime]") {
+    mun::Error err;
+    mun::RuntimeOptions options;
+    options.gc_collect_after_alloc_bytes = 4 * sizeof(int32_t[2]);
+    options.gc_collect_on_update = true;
+    if (auto runtime =
+            mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), options, &err)) {
+        REQUIRE(!err);
+
+        const auto s = mun::invoke_fn<mun::StructRef>(*runtime, "new_int32_t", 0, 0).unwrap();
+        const auto type_info = s.info();
+        REQUIRE(mun::type_info_size_in_bytes(*type_info) == sizeof(int32_t[2]));
+
+        std::array<MunGcPtr, 3> garbage{};
+        REQUIRE(runtime->gc_alloc_many(type_info, garbage));
+        REQUIRE(!runtime->update());
+        REQUIRE(runtime->gc_stats().num_collections == 0);
+        REQUIRE(runtime->gc_stats().types.empty());
+
+        // Crossing the threshold triggers a collection
+        REQUIRE(runtime->gc_alloc(type_info));
+        REQUIRE(!runtime->update());
+        auto stats = runtime->gc_stats();
+        REQUIRE(stats.num_collections == 1);
+        REQUIRE(stats.num_reclaiming_collections == 1);
+        REQUIRE(stats.bytes_allocated_since_collection == 0);
+
+        // The threshold grows with the objects that survive
+        mun::RootSet roots(*runtime);
+        REQUIRE(roots.alloc(type_info, 4));
+        REQUIRE(!runtime->update());
+        REQUIRE(runtime->gc_stats().num_collections == 2);
+
+        REQUIRE(roots.alloc(type_info, 4));
+        REQUIRE(!runtime->update());
+        REQUIRE(runtime->gc_stats().num_collections == 2);
+
+        REQUIRE(roots.alloc(type_info, 4));
+        REQUIRE(!runtime->update());
+        REQUIRE(runtime->gc_stats().num_collections == 3);
+
+        // ... and shrinks once they die
+        roots.clear();
+        REQUIRE(runtime->gc_collect());
+        REQUIRE(runtime->gc_stats().num_collections == 4);
+
+        std::array<MunGcPtr, 4> more_garbage{};
+        REQUIRE(runtime->gc_alloc_many(type_info, more_garbage));
+        REQUIRE(!runtime->update());
+        REQUIRE(runtime->gc_stats().num_collections == 5);
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("runtime stores large value structs out of line", "[runtime]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        // A `struct(value)` that does not fit inline
+        constexpr size_t SIZE = 2 * mun::ValueStruct::INLINE_CAPACITY;
+        MunTypeInfo type_info{};
+        type_info.name = "Large";
+        type_info.size_in_bits = SIZE * 8;
+        type_info.alignment = 1;
+        type_info.data.tag = MunTypeInfoData_Tag::Struct;
+        type_info.data.struct_.memory_kind = MunStructMemoryKind::Value;
+
+        std::array<uint8_t, SIZE> bytes{};
+        bytes.back() = 42;
+
+        mun::ValueStruct large(*runtime, type_info, bytes.data());
+        REQUIRE(!large.is_inline());
+        REQUIRE(large.size_in_bytes() == SIZE);
+
+        mun::ValueStruct copy = large;
+        REQUIRE(!copy.is_inline());
+        REQUIRE(copy.data() != large.data());
+
+        const auto data = copy.data();
+        mun::ValueStruct moved = std::move(copy);
+        REQUIRE(moved.data() == data);
+
+        large = moved;
+        REQUIRE(static_cast<const uint8_t*>(large.data())[SIZE - 1] == 42);
+
+        // Structs that fit inline are stored inline
+        const auto small = mun::invoke_fn<mun::ValueStruct>(*runtime, "new_value_struct", 1.0f,
+                                                            2.0f)
+                               .unwrap();
+        REQUIRE(small.is_inline());
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("function handle can be invoked", "[runtime]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        mun::Function<float(float, float)> marshal_float(*runtime, "marshal_float");
+        REQUIRE(marshal_float.is_valid());
+        REQUIRE(marshal_float(-3.14f, 6.28f).unwrap() == -3.14f + 6.28f);
+        REQUIRE(marshal_float(1.0f, 2.0f).unwrap() == 1.0f + 2.0f);
+
+        mun::Function<float(float)> invalid_arguments(*runtime, "marshal_float");
+        REQUIRE(!invalid_arguments.is_valid());
+        REQUIRE(invalid_arguments(1.0f).is_err());
+
+        mun::Function<int32_t(float, float)> invalid_return_type(*runtime, "marshal_float");
+        REQUIRE(!invalid_return_type.is_valid());
+
+        mun::Function<void()> missing(*runtime, "does_not_exist");
+        REQUIRE(!missing.is_valid());
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("runtime tracks its reload generation", "[runtime]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("fibonacci/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+        REQUIRE(runtime->generation() == 0);
+        REQUIRE(runtime->find_function_definition("fibonacci").has_value());
+
+        const auto generation = runtime->generation();
+        if (runtime->update(&err)) {
+            REQUIRE(runtime->generation() == generation + 1);
+            REQUIRE(runtime->last_update().generation == runtime->generation());
+        } else {
+            REQUIRE(runtime->generation() == generation);
+            REQUIRE(runtime->last_update().replaced_functions.empty());
+            REQUIRE(runtime->last_update().replaced_types.empty());
+        }
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("runtime reports the definitions replaced by a reload", "[runtime]") {
+    namespace fs = std::filesystem;
+    const auto dir = fs::temp_directory_path() / "mun_runtime_reload";
+    fs::create_directories(dir);
+    const auto library_path = dir / "mod.munlib";
+    fs::copy_file(get_munlib_path("marshal/target/mod.munlib"), library_path,
+                  fs::copy_options::overwrite_existing);
+
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(library_path.string(), {}, &err)) {
+        REQUIRE(!err);
+
+        const auto new_struct = runtime->find_function_definition("new_int32_t");
+        REQUIRE(new_struct.has_value());
+        const auto struct_guid = new_struct->prototype.signature.return_type->guid;
+        REQUIRE(runtime->find_function_definition("marshal_float").has_value());
+
+        // Replace the assembly with one that defines neither function
+        fs::copy_file(get_munlib_path("fibonacci/target/mod.munlib"), library_path,
+                      fs::copy_options::overwrite_existing);
+        REQUIRE(runtime->wait_for_update(std::chrono::seconds(10), &err));
+        REQUIRE(!err);
+
+        const auto& info = runtime->last_update();
+        REQUIRE(info.generation == 1);
+        const std::vector<std::string> replaced_functions = {"marshal_float", "new_int32_t"};
+        REQUIRE(info.replaced_functions == replaced_functions);
+        REQUIRE(std::any_of(
+            info.replaced_types.begin(), info.replaced_types.end(),
+            [&](const MunGuid& guid) { return mun::operator==(guid, struct_guid); }));
+        REQUIRE(!runtime->find_function_definition("new_int32_t").has_value());
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+    fs::remove_all(dir);
+}
+
+TEST_CASE("runtime can invoke functions asynchronously", "[runtime]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        auto ready = mun::invoke_async<float>(*runtime, "marshal_float", 1.0f, 2.0f);
+        REQUIRE(ready.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        REQUIRE(ready.get() == 1.0f + 2.0f);
+
+        // A failed invocation completes once a reload fixes it
+        auto pending = mun::invoke_async<int32_t>(*runtime, "marshal_float", 1.0f, 2.0f);
+        REQUIRE(pending.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+        // ... or reports a broken promise when the runtime is destroyed first
+        runtime.reset();
+        REQUIRE_THROWS_AS(pending.get(), std::future_error);
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+/// The result of writing a batch of `Output(float, float)` invocations to a span
+template <typename Output>
+using batch_into_t = decltype(std::declval<mun::Function<Output(float, float)>&>().invoke_batch(
+    std::declval<mun::Span<Output>>(), std::declval<mun::Span<const float>>(),
+    std::declval<mun::Span<const float>>()));
+
+template <typename Output, typename = void>
+struct can_batch_into : std::false_type {};
+
+template <typename Output>
+struct can_batch_into<Output, std::void_t<batch_into_t<Output>>> : std::true_type {};
+
+TEST_CASE("runtime can invoke functions in batches", "[runtime]") {
+    static_assert(can_batch_into<float>::value);
+    static_assert(!can_batch_into<mun::StructRef>::value,
+                  "outputs must be default constructible");
+
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        const std::vector<float> lhs = {-3.14f, 1.0f, 2.5f};
+        const std::vector<float> rhs = {6.28f, 2.0f, -2.5f};
+        std::vector<float> out(lhs.size());
+        REQUIRE(mun::invoke_batch<float, float, float>(*runtime, "marshal_float", out, lhs, rhs));
+        for (size_t idx = 0; idx < out.size(); ++idx) {
+            REQUIRE(out[idx] == lhs[idx] + rhs[idx]);
+        }
+
+        // Mismatching span sizes
+        std::vector<float> short_out(1);
+        REQUIRE(!mun::invoke_batch<float, float, float>(*runtime, "marshal_float", short_out, lhs,
+                                                        rhs));
+
+        // Mismatching signature
+        std::vector<int32_t> int_out(lhs.size());
+        REQUIRE(!mun::invoke_batch<int32_t, float, float>(*runtime, "marshal_float", int_out,
+                                                          lhs, rhs));
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}
+
+TEST_CASE("runtime reports invocation errors", "[runtime]") {
+    mun::Error err;
+    if (auto runtime = mun::make_runtime(get_munlib_path("marshal/target/mod.munlib"), {}, &err)) {
+        REQUIRE(!err);
+
+        std::vector<mun::InvokeErrorKind> reported;
+        mun::DiagnosticSink sink;
+        sink.user_data = &reported;
+        sink.on_invoke_error = [](std::string_view, const mun::InvokeError& error,
+                                  void* user_data) {
+            static_cast<std::vector<mun::InvokeErrorKind>*>(user_data)->push_back(error.kind);
+        };
+        runtime->set_diagnostic_sink(sink);
+
+        auto missing = mun::invoke_fn<void>(*runtime, "does_not_exist");
+        REQUIRE(missing.is_err());
+        REQUIRE(missing.error().kind == mun::InvokeErrorKind::FunctionNotFound);
+
+        auto num_args = mun::invoke_fn<float>(*runtime, "marshal_float", 1.0f);
+        REQUIRE(num_args.is_err());
+        REQUIRE(num_args.error().kind == mun::InvokeErrorKind::ArgumentCountMismatch);
+        REQUIRE(num_args.error().expected_num_args == 2);
+        REQUIRE(num_args.error().found_num_args == 1);
+
+        auto arg_type = mun::invoke_fn<float>(*runtime, "marshal_float", 1.0f, 2);
+        REQUIRE(arg_type.is_err());
+        REQUIRE(arg_type.error().kind == mun::InvokeErrorKind::ArgumentTypeMismatch);
+        REQUIRE(arg_type.error().arg_index == 1);
+
+        auto return_type = mun::invoke_fn<int32_t>(*runtime, "marshal_float", 1.0f, 2.0f);
+        REQUIRE(return_type.is_err());
+        REQUIRE(return_type.error().kind == mun::InvokeErrorKind::ReturnTypeMismatch);
+
+        // The failed invocation owns the function's name and arguments.
+        auto failure = return_type.unwrap_err();
+        REQUIRE(failure.runtime == &*runtime);
+        REQUIRE(failure.fn_name.view() == "marshal_float");
+        REQUIRE(failure.args == std::tuple(1.0f, 2.0f));
+
+        REQUIRE(reported == std::vector<mun::InvokeErrorKind>{
+                                mun::InvokeErrorKind::FunctionNotFound,
+                                mun::InvokeErrorKind::ArgumentCountMismatch,
+                                mun::InvokeErrorKind::ArgumentTypeMismatch,
+                                mun::InvokeErrorKind::ReturnTypeMismatch,
+                            });
+    } else {
+        REQUIRE(err);
+        FAIL(err.message());
+    }
+}